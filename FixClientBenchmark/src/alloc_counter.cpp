@@ -0,0 +1,76 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// alloc_counter.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "alloc_counter.hpp"
+
+namespace {
+
+  std::atomic<std::uint64_t> allocations { 0 };
+
+  void* allocate(std::size_t size)
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+      return pointer;
+    }
+    throw std::bad_alloc();
+  }
+
+} // Namespace
+
+namespace FixClientBenchmark {
+
+  std::uint64_t allocationCount()
+  {
+    return allocations.load(std::memory_order_relaxed);
+  }
+
+} // Namespace FixClientBenchmark
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Global Operators
+
+void* operator new(std::size_t size)
+{
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
@@ -0,0 +1,85 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// alloc_counter.hpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Counts heap allocations made by the benchmark binary. The global
+// operator new is replaced in alloc_counter.cpp.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+namespace FixClientBenchmark {
+
+  // Allocations since the process started, all threads
+  std::uint64_t allocationCount();
+
+  // Counts from construction, create it right before the timed loop.
+  // One message per iteration, so the average is allocations per message.
+  class AllocationCounter
+  {
+
+    public:
+
+      AllocationCounter() :
+        start_(allocationCount())
+      {
+        // Nada
+      }
+
+      std::uint64_t allocations() const
+      {
+        return allocationCount() - start_;
+      }
+
+      // Returns the count it reported. Adding the counter allocates, so
+      // allocations() is off by one afterwards.
+      std::uint64_t report(benchmark::State& state) const
+      {
+        const std::uint64_t count = allocations();
+
+        state.counters["allocs/msg"] = benchmark::Counter(
+          static_cast<double>(count),
+          benchmark::Counter::kAvgIterations
+        );
+        return count;
+      }
+
+    private:
+
+      std::uint64_t start_;
+
+  };
+
+  // Runs work once to grow its buffers, then times it. Skips with an
+  // error if the timed runs still allocated.
+  template <typename Work>
+  void runWithoutAllocating(benchmark::State& state, Work&& work)
+  {
+    work();
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      work();
+    }
+
+    if (counter.report(state) != 0) {
+      state.SkipWithError("Steady state run allocated");
+    }
+  }
+
+} // Namespace FixClientBenchmark
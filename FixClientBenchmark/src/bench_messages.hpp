@@ -0,0 +1,243 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// bench_messages.hpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Pre-built OpenYield FIX 4.4 messages shaped like the production feeds.
+// Built once per benchmark, outside the timed loop.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <string>
+
+#include <fmt/core.h>
+
+#include "quickfix.hpp"
+
+namespace FixClientBenchmark {
+
+  // A US Treasury style ISIN, unique per index
+  inline std::string isin(int index)
+  {
+    return fmt::format("US91282C{:04d}", index % 10000);
+  }
+
+  inline void setHeader(FIX::Message& message, const std::string& sender)
+  {
+    message.getHeader().setField(FIX::BeginString(FIX::BeginString_FIX44));
+    message.getHeader().setField(FIX::SenderCompID(sender));
+    message.getHeader().setField(FIX::TargetCompID("CLIENT-MD"));
+    message.getHeader().setField(FIX::MsgSeqNum(1));
+    message.getHeader().setField(FIX::SendingTime());
+  }
+
+  // -------- -------- -------- --------
+  // MARK: Market Data
+
+  // Alternating bid/offer changes across `entries` securities
+  inline FIX44::MarketDataIncrementalRefresh incrementalRefresh(int entries)
+  {
+    FIX44::MarketDataIncrementalRefresh message;
+    setHeader(message, "OPENYIELD-MD");
+
+    for (int i = 0; i < entries; ++i) {
+      FIX44::MarketDataIncrementalRefresh::NoMDEntries group;
+      group.set(FIX::MDUpdateAction(FIX::MDUpdateAction_CHANGE));
+      group.set(FIX::MDEntryType(
+        i % 2 == 0 ? FIX::MDEntryType_BID : FIX::MDEntryType_OFFER
+      ));
+      group.set(FIX::SecurityID(isin(i / 2)));
+      group.set(FIX::MDEntryPx(99.5 + (i % 16) / 32.0));
+      group.set(FIX::MDEntrySize(1000000 + 250000 * (i % 4)));
+      group.set(FIX::PriceDelta(4.125 + (i % 8) / 100.0));
+      message.addGroup(group);
+    }
+
+    return message;
+  }
+
+  // One security's bid, offer and last trade, repeated to `entries`
+  inline FIX44::MarketDataSnapshotFullRefresh snapshotFullRefresh(
+    int entries)
+  {
+    static constexpr char entryTypes[] = {
+      FIX::MDEntryType_BID, FIX::MDEntryType_OFFER, FIX::MDEntryType_TRADE
+    };
+
+    FIX44::MarketDataSnapshotFullRefresh message;
+    setHeader(message, "OPENYIELD-MD");
+    message.set(FIX::SecurityID(isin(0)));
+
+    for (int i = 0; i < entries; ++i) {
+      FIX44::MarketDataSnapshotFullRefresh::NoMDEntries group;
+      group.set(FIX::MDEntryType(entryTypes[i % 3]));
+      group.set(FIX::MDEntryPx(99.5 + (i % 16) / 32.0));
+      group.set(FIX::MDEntrySize(1000000 + 250000 * (i % 4)));
+      group.set(FIX::PriceDelta(4.125 + (i % 8) / 100.0));
+      message.addGroup(group);
+    }
+
+    return message;
+  }
+
+  // -------- -------- -------- --------
+  // MARK: Order Book
+
+  inline FIX44::IOI ioi(int index)
+  {
+    FIX44::IOI message(
+      FIX::IOIID(fmt::format("IOI{:08d}", index)),
+      FIX::IOITransType(FIX::IOITransType_REPLACE),
+      FIX::Side(index % 2 == 0 ? FIX::Side_BUY : FIX::Side_SELL),
+      FIX::IOIQty("1000000")
+    );
+    setHeader(message, "OPENYIELD-OB");
+
+    message.set(FIX::SecurityID(isin(index)));
+    message.set(FIX::Price(99.5 + (index % 16) / 32.0));
+    message.set(FIX::Yield(4.125 + (index % 8) / 100.0));
+    message.set(FIX::IOIQltyInd(FIX::IOIQltyInd_HIGH));
+
+    return message;
+  }
+
+  // -------- -------- -------- --------
+  // MARK: Execution Reports
+
+  inline FIX44::ExecutionReport executionReport(char execType,
+    char ordStatus, double leavesQty, double cumQty)
+  {
+    FIX44::ExecutionReport message(
+      FIX::OrderID("OY00012345"),
+      FIX::ExecID("EX00067890"),
+      FIX::ExecType(execType),
+      FIX::OrdStatus(ordStatus),
+      FIX::Side(FIX::Side_BUY),
+      FIX::LeavesQty(leavesQty),
+      FIX::CumQty(cumQty),
+      FIX::AvgPx(cumQty > 0 ? 99.5 : 0)
+    );
+    setHeader(message, "OPENYIELD-TR");
+
+    message.set(FIX::ClOrdID("CL00012345"));
+    message.set(FIX::SecurityID(isin(0)));
+    message.set(FIX::TransactTime());
+
+    return message;
+  }
+
+  inline void addParty(FIX44::ExecutionReport& message,
+    const std::string& partyId, int role)
+  {
+    FIX44::ExecutionReport::NoPartyIDs party;
+    party.set(FIX::PartyID(partyId));
+    party.set(FIX::PartyRole(role));
+    message.addGroup(party);
+  }
+
+  inline FIX44::ExecutionReport orderAcknowledgement()
+  {
+    auto message = executionReport(
+      FIX::ExecType_NEW, FIX::OrdStatus_NEW, 1000000, 0
+    );
+    addParty(message, "BENCHFIRM", FIX::PartyRole_EXECUTING_FIRM);
+
+    return message;
+  }
+
+  // A partial fill with the contra firm, its clearing account, the
+  // executing firm and the subscriber account
+  inline FIX44::ExecutionReport fill()
+  {
+    auto message = executionReport(
+      FIX::ExecType_TRADE, FIX::OrdStatus_PARTIALLY_FILLED, 750000, 250000
+    );
+
+    FIX44::ExecutionReport::NoPartyIDs contra;
+    contra.set(FIX::PartyID("CONTRAMPID"));
+    contra.set(FIX::PartyRole(FIX::PartyRole_CONTRA_FIRM));
+    FIX44::ExecutionReport::NoPartyIDs::NoPartySubIDs account;
+    account.set(FIX::PartySubID("CONTRA-ACCOUNT-001"));
+    account.set(FIX::PartySubIDType(1));
+    contra.addGroup(account);
+    message.addGroup(contra);
+
+    addParty(message, "BENCHFIRM", FIX::PartyRole_EXECUTING_FIRM);
+    addParty(message, "SUBSCRIBER-001", FIX::PartyRole_CUSTOMER_ACCOUNT);
+
+    message.set(FIX::LastQty(250000));
+    message.set(FIX::LastPx(99.5));
+    message.set(FIX::Yield(4.125));
+    message.set(FIX::GrossTradeAmt(248750));
+    message.set(FIX::AccruedInterestAmt(1432.29));
+    message.set(FIX::NetMoney(250182.29));
+    message.set(FIX::SettlDate("20241105"));
+
+    return message;
+  }
+
+  inline FIX44::ExecutionReport tradeCorrection()
+  {
+    auto message = executionReport(
+      FIX::ExecType_TRADE_CORRECT, FIX::OrdStatus_PARTIALLY_FILLED,
+      750000, 250000
+    );
+    addParty(message, "BENCHFIRM", FIX::PartyRole_EXECUTING_FIRM);
+
+    message.set(FIX::ExecRefID("EX00067889"));
+    message.set(FIX::LastQty(250000));
+    message.set(FIX::LastPx(99.625));
+    message.set(FIX::Yield(4.1));
+    message.set(FIX::GrossTradeAmt(249062.5));
+    message.set(FIX::AccruedInterestAmt(1432.29));
+    message.set(FIX::NetMoney(250494.79));
+
+    return message;
+  }
+
+  // -------- -------- -------- --------
+  // MARK: Security List
+
+  inline FIX44::SecurityList securityList(int securities)
+  {
+    FIX44::SecurityList message;
+    setHeader(message, "OPENYIELD-TR");
+    message.set(FIX::SecurityReqID("SECLIST-1"));
+    message.set(FIX::SecurityResponseID("SECLIST-1"));
+
+    for (int i = 0; i < securities; ++i) {
+      FIX44::SecurityList::NoRelatedSym group;
+      group.set(FIX::Symbol(isin(i)));
+      group.set(FIX::SecurityID(isin(i)));
+      group.set(FIX::SecurityIDSource(FIX::SecurityIDSource_ISIN_NUMBER));
+      message.addGroup(group);
+    }
+
+    return message;
+  }
+
+  // -------- -------- -------- --------
+  // MARK: Session State
+
+  inline FIX44::TradingSessionStatus tradingSessionStatus(int status)
+  {
+    FIX44::TradingSessionStatus message(
+      FIX::TradingSessionID("OYLD"),
+      FIX::TradSesStatus(status)
+    );
+    setHeader(message, "OPENYIELD-TR");
+
+    return message;
+  }
+
+} // Namespace FixClientBenchmark
@@ -0,0 +1,70 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// execution_event_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <benchmark/benchmark.h>
+
+#include "codec/execution_event.hpp"
+#include "state/security_table.hpp"
+
+#include "alloc_counter.hpp"
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Execution Reports
+
+  // Acknowledgement, fill with party groups, or trade correction
+  static void BM_ExecutionReport(benchmark::State& state,
+    FIX44::ExecutionReport (*build)())
+  {
+    auto message = build();
+    ExecutionEventCodec codec;
+
+    if (!codec.onExecutionReport(message).has_value()) {
+      state.SkipWithError("Execution report not handled");
+      return;
+    }
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(codec.onExecutionReport(message));
+    }
+
+    counter.report(state);
+  }
+
+  static void BM_ExecutionReportIntoModel(benchmark::State& state,
+    FIX44::ExecutionReport (*build)())
+  {
+    auto message = build();
+    SecurityTable securities;
+    ExecutionEventCodec codec(&securities);
+    ExecutionEventModel event;
+
+    runWithoutAllocating(state, [&] {
+      benchmark::DoNotOptimize(codec.onExecutionReport(message, event));
+    });
+  }
+
+  BENCHMARK_CAPTURE(BM_ExecutionReport, Ack, orderAcknowledgement);
+  BENCHMARK_CAPTURE(BM_ExecutionReport, Fill, fill);
+  BENCHMARK_CAPTURE(BM_ExecutionReport, Correction, tradeCorrection);
+  BENCHMARK_CAPTURE(BM_ExecutionReportIntoModel, Ack, orderAcknowledgement);
+  BENCHMARK_CAPTURE(BM_ExecutionReportIntoModel, Fill, fill);
+  BENCHMARK_CAPTURE(BM_ExecutionReportIntoModel, Correction, tradeCorrection);
+
+} // Namespace FixClientBenchmark
@@ -0,0 +1,198 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// market_data_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <benchmark/benchmark.h>
+
+#include "codec/market_data.hpp"
+#include "codec/raw_market_data.hpp"
+#include "state/security_table.hpp"
+
+#include "alloc_counter.hpp"
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Incremental Refresh
+
+  // Cracked message through MarketDataCodec (FixEngine default)
+  static void BM_IncrementalRefreshQuickFix(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(static_cast<int>(state.range(0)));
+    MarketDataCodec codec;
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+        codec.onMarketDataIncrementalRefresh(message)
+      );
+    }
+
+    counter.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  // Wire bytes through RawMarketDataCodec
+  static void BM_IncrementalRefreshRaw(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(static_cast<int>(state.range(0)));
+    std::string raw = message.toString();
+    RawMarketDataCodec codec;
+
+    // Both decoders must agree before the numbers mean anything
+    if ( codec.onMarketDataIncrementalRefresh(raw)
+      != MarketDataCodec().onMarketDataIncrementalRefresh(message)
+    ) {
+      state.SkipWithError("Raw decoder output differs from MarketDataCodec");
+      return;
+    }
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+        codec.onMarketDataIncrementalRefresh(raw)
+      );
+    }
+
+    counter.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  // What FixEngine does with MarketDataDecoder::Raw, where QuickFIX
+  // hands over a parsed message that has to be serialized again
+  static void BM_IncrementalRefreshRawFromMessage(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(static_cast<int>(state.range(0)));
+    std::string raw;
+    RawMarketDataCodec codec;
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      message.toString(raw);
+      benchmark::DoNotOptimize(
+        codec.onMarketDataIncrementalRefresh(raw)
+      );
+    }
+
+    counter.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Snapshot Full Refresh
+
+  static void BM_SnapshotFullRefreshQuickFix(benchmark::State& state)
+  {
+    auto message = snapshotFullRefresh(static_cast<int>(state.range(0)));
+    MarketDataCodec codec;
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(
+        codec.onMarketDataSnapshotFullRefresh(message)
+      );
+    }
+
+    counter.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Caller-Owned Buffers
+
+  static void BM_IncrementalRefreshQuickFixIntoBuffer(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(static_cast<int>(state.range(0)));
+    SecurityTable securities;
+    MarketDataCodec codec(&securities);
+    std::vector<MarketDataModel> data;
+
+    runWithoutAllocating(state, [&] {
+      codec.onMarketDataIncrementalRefresh(message, data);
+      benchmark::DoNotOptimize(data.data());
+    });
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void BM_IncrementalRefreshQuickFixSink(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(static_cast<int>(state.range(0)));
+    SecurityTable securities;
+    MarketDataCodec codec(&securities);
+    double total = 0;
+
+    runWithoutAllocating(state, [&] {
+      codec.onMarketDataIncrementalRefresh(message,
+        [&](const MarketDataModel& model) {
+          total += model.price;
+        }
+      );
+      benchmark::DoNotOptimize(total);
+    });
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void BM_SnapshotFullRefreshIntoBuffer(benchmark::State& state)
+  {
+    auto message = snapshotFullRefresh(static_cast<int>(state.range(0)));
+    SecurityTable securities;
+    MarketDataCodec codec(&securities);
+    std::vector<MarketDataModel> data;
+
+    runWithoutAllocating(state, [&] {
+      codec.onMarketDataSnapshotFullRefresh(message, data);
+      benchmark::DoNotOptimize(data.data());
+    });
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void BM_IncrementalRefreshRawIntoBuffer(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(static_cast<int>(state.range(0)));
+    std::string raw = message.toString();
+    SecurityTable securities;
+    RawMarketDataCodec codec(&securities);
+    std::vector<MarketDataModel> data;
+
+    runWithoutAllocating(state, [&] {
+      codec.onMarketDataIncrementalRefresh(raw, data);
+      benchmark::DoNotOptimize(data.data());
+    });
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  BENCHMARK(BM_IncrementalRefreshQuickFix)->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_IncrementalRefreshRaw)->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_IncrementalRefreshRawFromMessage)
+    ->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_SnapshotFullRefreshQuickFix)->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_IncrementalRefreshQuickFixIntoBuffer)
+    ->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_IncrementalRefreshQuickFixSink)
+    ->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_SnapshotFullRefreshIntoBuffer)
+    ->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_IncrementalRefreshRawIntoBuffer)
+    ->RangeMultiplier(4)->Range(1, 512);
+
+} // Namespace FixClientBenchmark
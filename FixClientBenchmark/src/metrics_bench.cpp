@@ -0,0 +1,41 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// metrics_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <benchmark/benchmark.h>
+
+#include "metrics/latency_metrics.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Latency Metrics
+
+  // What the engine adds per stage with FIXCLIENT_LATENCY_METRICS on
+  static void BM_LatencyStampAndRecord(benchmark::State& state)
+  {
+    LatencyMetrics metrics;
+
+    for (auto _ : state) {
+      const std::uint64_t start = readCycles();
+      metrics.record(LatencyMessage::IOI, LatencyStage::Decode,
+        readCycles() - start);
+    }
+
+    benchmark::DoNotOptimize(metrics);
+  }
+
+  BENCHMARK(BM_LatencyStampAndRecord);
+
+} // Namespace FixClientBenchmark
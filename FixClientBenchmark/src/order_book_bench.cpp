@@ -0,0 +1,59 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_book_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <benchmark/benchmark.h>
+
+#include "codec/order_book.hpp"
+#include "state/security_table.hpp"
+
+#include "alloc_counter.hpp"
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: IOI
+
+  static void BM_IOI(benchmark::State& state)
+  {
+    auto message = ioi(1);
+    OrderBookCodec codec;
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(codec.onIOI(message));
+    }
+
+    counter.report(state);
+  }
+
+  static void BM_IOIIntoModel(benchmark::State& state)
+  {
+    auto message = ioi(1);
+    SecurityTable securities;
+    OrderBookCodec codec(&securities);
+    IOIOrderModel model;
+
+    runWithoutAllocating(state, [&] {
+      codec.onIOI(message, model);
+      benchmark::DoNotOptimize(model);
+    });
+  }
+
+  BENCHMARK(BM_IOI);
+  BENCHMARK(BM_IOIIntoModel);
+
+} // Namespace FixClientBenchmark
@@ -0,0 +1,118 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_dispatch_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <benchmark/benchmark.h>
+
+#include "dispatch/order.hpp"
+
+#include "alloc_counter.hpp"
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+  // -------- -------- -------- --------
+  // MARK: Orders
+
+  static OrderModel order(OrderAction action)
+  {
+    return OrderModel {
+      .action = action,
+      .orderCode = "CL00012346",
+      .originalOrderCode = "CL00012345",
+      .kind = OrderKind::Limit,
+      .counterpartyCode = "BENCHFIRM",
+      .side = OrderSide::Buy,
+      .security = SecurityModel {
+        .code = isin(0),
+        .kind = SecurityCodeKind::ISIN
+      },
+      .quantity = 1000000,
+      .price = 99.5
+    };
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Message Construction
+
+  // What sendOrder() builds before QuickFIX serializes and sends it. The
+  // send itself needs a logged on session.
+  template <typename Build>
+  static void buildOrder(benchmark::State& state, OrderAction action,
+    Build&& build)
+  {
+    OrderDispatch dispatch("BENCH");
+    OrderModel model = order(action);
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(build(dispatch, model));
+    }
+
+    counter.report(state);
+  }
+
+  static void BM_NewOrderMessage(benchmark::State& state)
+  {
+    buildOrder(state, OrderAction::New,
+      [](const OrderDispatch& dispatch, const OrderModel& model) {
+        return dispatch.newOrderMessage(model);
+      }
+    );
+  }
+
+  static void BM_ReplaceOrderMessage(benchmark::State& state)
+  {
+    buildOrder(state, OrderAction::Replace,
+      [](const OrderDispatch& dispatch, const OrderModel& model) {
+        return dispatch.replaceOrderMessage(model);
+      }
+    );
+  }
+
+  static void BM_CancelOrderMessage(benchmark::State& state)
+  {
+    buildOrder(state, OrderAction::Cancel,
+      [](const OrderDispatch& dispatch, const OrderModel& model) {
+        return dispatch.cancelOrderMessage(model);
+      }
+    );
+  }
+
+  // Construction plus the wire string QuickFIX would send
+  static void BM_NewOrderSerialized(benchmark::State& state)
+  {
+    OrderDispatch dispatch("BENCH");
+    OrderModel model = order(OrderAction::New);
+    std::string raw;
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      FIX44::NewOrderSingle message = dispatch.newOrderMessage(model);
+      setHeader(message, "BENCH-TR");
+      message.toString(raw);
+      benchmark::DoNotOptimize(raw.data());
+    }
+
+    counter.report(state);
+  }
+
+  BENCHMARK(BM_NewOrderMessage);
+  BENCHMARK(BM_ReplaceOrderMessage);
+  BENCHMARK(BM_CancelOrderMessage);
+  BENCHMARK(BM_NewOrderSerialized);
+
+} // Namespace FixClientBenchmark
@@ -0,0 +1,87 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_submitter_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <memory>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "dispatch/order_submitter.hpp"
+#include "dispatch/risk_gate.hpp"
+
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+  // -------- -------- -------- --------
+  // MARK: Orders
+
+  static OrderModel order()
+  {
+    return OrderModel {
+      .action = OrderAction::New,
+      .orderCode = "CL00012345",
+      .originalOrderCode = "",
+      .kind = OrderKind::Limit,
+      .counterpartyCode = "BENCHFIRM",
+      .side = OrderSide::Buy,
+      .security = SecurityModel {
+        .code = isin(0),
+        .kind = SecurityCodeKind::ISIN
+      },
+      .quantity = 1000000,
+      .price = 99.5
+    };
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Submission
+
+  // Shared by the benchmark's threads
+  static std::unique_ptr<OrderSubmitter> submitter;
+
+  // Strategy threads submitting at once, the send itself does nothing.
+  // A full queue is retried, so this is the rate the sender thread
+  // drains at once the queue fills up.
+  static void BM_SubmitOrder(benchmark::State& state)
+  {
+    if (state.thread_index() == 0) {
+      submitter = std::make_unique<OrderSubmitter>(4096,
+        [](const OrderModel& model) {
+          benchmark::DoNotOptimize(model.quantity);
+          return RiskCheck::Passed;
+        }
+      );
+    }
+
+    const OrderModel model = order();
+
+    for (auto _ : state) {
+      while (!submitter->submit(model).accepted()) {
+        std::this_thread::yield();
+      }
+    }
+
+    if (state.thread_index() == 0) {
+      state.counters["p99_ns"] = static_cast<double>(
+        submitter->submitTime().percentile(0.99)
+      );
+      submitter.reset();
+    }
+  }
+
+  BENCHMARK(BM_SubmitOrder)->Threads(1)->Threads(4)->UseRealTime();
+
+} // Namespace FixClientBenchmark
@@ -0,0 +1,90 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// risk_gate_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <benchmark/benchmark.h>
+
+#include "dispatch/risk_gate.hpp"
+
+#include "alloc_counter.hpp"
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+  // -------- -------- -------- --------
+  // MARK: Orders
+
+  static OrderModel order()
+  {
+    return OrderModel {
+      .action = OrderAction::New,
+      .orderCode = "CL00012345",
+      .originalOrderCode = "",
+      .kind = OrderKind::Limit,
+      .counterpartyCode = "BENCHFIRM",
+      .side = OrderSide::Buy,
+      .security = SecurityModel {
+        .code = isin(0),
+        .kind = SecurityCodeKind::ISIN
+      },
+      .quantity = 1000000,
+      .price = 99.5
+    };
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Checks
+
+  // The check sendOrder() runs before building the message. The order
+  // is released again each time, as its fill would, so the exposure
+  // stays under the limits.
+  static void checkOrder(benchmark::State& state, const RiskLimits& limits)
+  {
+    RiskGate gate(limits);
+    OrderModel model = order();
+    const double exposure = notionalOf(model);
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(gate.check(model, exposure));
+      gate.adjust(model.security.code, -exposure);
+    }
+
+    counter.report(state);
+  }
+
+  // Every limit on, the message rate high enough never to block
+  static void BM_RiskGateCheck(benchmark::State& state)
+  {
+    RiskLimits limits;
+    limits.maxOrderQuantity = 5000000;
+    limits.maxOrderNotional = 5000000;
+    limits.maxSecurityExposure = 10000000;
+    limits.maxGrossExposure = 50000000;
+    limits.maxMessagesPerSecond = 1000000000;
+
+    checkOrder(state, limits);
+  }
+
+  // Every limit off, what an unconfigured OrderDispatch pays
+  static void BM_RiskGateUnlimited(benchmark::State& state)
+  {
+    checkOrder(state, RiskLimits {});
+  }
+
+  BENCHMARK(BM_RiskGateCheck);
+  BENCHMARK(BM_RiskGateUnlimited);
+
+} // Namespace FixClientBenchmark
@@ -0,0 +1,60 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// security_list_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <benchmark/benchmark.h>
+
+#include "codec/security_list.hpp"
+
+#include "alloc_counter.hpp"
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Security List
+
+  static void BM_SecurityList(benchmark::State& state)
+  {
+    auto message = securityList(static_cast<int>(state.range(0)));
+    SecurityCodec codec;
+
+    AllocationCounter counter;
+
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(codec.onSecurityList(message));
+    }
+
+    counter.report(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  static void BM_SecurityListIntoBuffer(benchmark::State& state)
+  {
+    auto message = securityList(static_cast<int>(state.range(0)));
+    SecurityCodec codec;
+    std::vector<SecurityModel> data;
+
+    runWithoutAllocating(state, [&] {
+      codec.onSecurityList(message, data);
+      benchmark::DoNotOptimize(data.data());
+    });
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  BENCHMARK(BM_SecurityList)->RangeMultiplier(4)->Range(1, 512);
+  BENCHMARK(BM_SecurityListIntoBuffer)->RangeMultiplier(4)->Range(1, 512);
+
+} // Namespace FixClientBenchmark
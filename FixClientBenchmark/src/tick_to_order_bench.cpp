@@ -0,0 +1,222 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// tick_to_order_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// End to end, over a LoopbackTransport: from an incremental refresh
+// reaching the client's MD session to the NewOrderSingle the workflow
+// answers it with leaving the client's TR session, serialized. One
+// tick in flight at a time. The order goes through the workflow's
+// sendOrder: coalescer, order cache, risk gate and the TR session the
+// engine hands the workflow at logon.
+//
+// The sessions parse with a data dictionary, point
+// FIXCLIENT_DATA_DICTIONARY at the FIX44.xml the OpenYield sessions are
+// configured with to run these.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include "fix_engine.hpp"
+#include "metrics/cycle_clock.hpp"
+#include "metrics/latency_histogram.hpp"
+#include "transport/loopback_transport.hpp"
+
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+  // -------- -------- -------- --------
+  // MARK: Workflow and Venue
+
+  // Buys whatever ticks
+  class OrderingWorkflow final : public WorkflowInterface
+  {
+    public:
+
+      // The venue never answers, so every order stays in the order
+      // cache. One per iteration, past them they would fail Untracked.
+      static constexpr std::size_t maxOrders = 50000;
+
+      OrderingWorkflow() : WorkflowInterface("BENCH", maxOrders) {}
+
+      void onMarketData(
+        const std::vector<MarketDataModel>& model) const override
+      {
+        order_.orderCode = fmt::format("CL{:010d}", ++orders_);
+        order_.security.code = model.front().securityCode;
+        order_.price = model.front().price;
+
+        // The engine's callbacks are const, sending moves the order
+        // cache on. The workflow itself is not const.
+        auto* self = const_cast<OrderingWorkflow*>(this);
+        if (self->sendOrder(order_) != RiskCheck::Passed) {
+          blocked_.store(true, std::memory_order_release);
+        }
+      }
+
+      // An order was not sent, no order will leave for the tick
+      bool blocked() const
+      {
+        return blocked_.load(std::memory_order_acquire);
+      }
+
+    private:
+
+      mutable std::atomic<bool> blocked_ { false };
+
+      mutable OrderModel order_ {
+        .action = OrderAction::New,
+        .orderCode = {},
+        .originalOrderCode = {},
+        .kind = OrderKind::Limit,
+        .counterpartyCode = "BENCHFIRM",
+        .side = OrderSide::Buy,
+        .security = SecurityModel {
+          .code = {},
+          .kind = SecurityCodeKind::ISIN
+        },
+        .quantity = 1000000,
+        .price = 0
+      };
+
+      mutable std::uint64_t orders_ { 0 };
+  };
+
+  // Takes the orders and says nothing
+  class SilentVenue : public FIX::Application
+  {
+    public:
+
+      void onCreate(const FIX::SessionID&) override {}
+      void onLogon(const FIX::SessionID&) override {}
+      void onLogout(const FIX::SessionID&) override {}
+      void toAdmin(FIX::Message&, const FIX::SessionID&) override {}
+      void toApp(FIX::Message&, const FIX::SessionID&) override {}
+      void fromAdmin(const FIX::Message&, const FIX::SessionID&) override {}
+      void fromApp(const FIX::Message&, const FIX::SessionID&) override {}
+  };
+
+  // -------- -------- -------- --------
+  // MARK: Tap
+
+  // Stamps the tick on the way in and the order on the way out
+  struct TickToOrderTap
+  {
+    void operator()(LoopbackDirection direction,
+      [[ maybe_unused ]] const FIX::SessionID& sessionID,
+      const std::string& message)
+    {
+      if ( direction == LoopbackDirection::ToClient
+        && message.find("\x01" "35=X\x01") != std::string::npos
+      ) {
+        tickAt->store(readCycles(), std::memory_order_relaxed);
+      } else if ( direction == LoopbackDirection::FromClient
+        && message.find("\x01" "35=D\x01") != std::string::npos
+      ) {
+        orderAt->store(readCycles(), std::memory_order_release);
+      }
+    }
+
+    std::atomic<std::uint64_t>* tickAt;
+    std::atomic<std::uint64_t>* orderAt;
+  };
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Tick to Order
+
+  static void BM_TickToOrder(benchmark::State& state, EventDispatch mode)
+  {
+    const char* dictionary = std::getenv("FIXCLIENT_DATA_DICTIONARY");
+    if (!dictionary) {
+      state.SkipWithError("Set FIXCLIENT_DATA_DICTIONARY to a FIX44.xml");
+      return;
+    }
+
+    auto workflow = std::make_shared<OrderingWorkflow>();
+    BasicFixEngine<OrderingWorkflow> engine(workflow,
+      MarketDataDecoder::QuickFix, DispatchOptions { .mode = mode });
+    SilentVenue venue;
+
+    std::atomic<std::uint64_t> tickAt { 0 };
+    std::atomic<std::uint64_t> orderAt { 0 };
+
+    LoopbackTransport transport(engine, venue,
+      LoopbackOptions {
+        .dataDictionary = dictionary,
+        .compId = "BENCH",
+        .spin = true
+      },
+      TickToOrderTap { &tickAt, &orderAt }
+    );
+    transport.start();
+
+    if (!transport.waitForLogon(std::chrono::seconds(5))) {
+      state.SkipWithError("Loopback sessions did not log on");
+      return;
+    }
+
+    // -MD, -OB, -TR
+    const FIX::SessionID& venueMarketData = transport.venueSessions()[0];
+
+    auto tick = incrementalRefresh(1);
+    const double nanosecondsPerTick = nanosecondsPerCycle();
+
+    LatencyHistogram histogram;
+
+    for (auto _ : state) {
+      orderAt.store(0, std::memory_order_relaxed);
+      FIX::Session::sendToTarget(tick, venueMarketData);
+
+      std::uint64_t sentAt = 0;
+      while ((sentAt = orderAt.load(std::memory_order_acquire)) == 0) {
+        if (workflow->blocked()) {
+          break;
+        }
+      }
+
+      if (sentAt == 0) {
+        state.SkipWithError("The workflow's order was blocked");
+        break;
+      }
+
+      const double nanoseconds =
+        (sentAt - tickAt.load(std::memory_order_relaxed))
+        * nanosecondsPerTick;
+      histogram.record(static_cast<std::uint64_t>(nanoseconds));
+      state.SetIterationTime(nanoseconds / 1e9);
+    }
+
+    transport.stop();
+
+    state.counters["p50_ns"] = histogram.percentile(0.50);
+    state.counters["p99_ns"] = histogram.percentile(0.99);
+    state.counters["p99.9_ns"] = histogram.percentile(0.999);
+    state.counters["max_ns"] = histogram.max();
+  }
+
+  BENCHMARK_CAPTURE(BM_TickToOrder, Inline, EventDispatch::Inline)
+    ->UseManualTime()->Iterations(OrderingWorkflow::maxOrders);
+  BENCHMARK_CAPTURE(BM_TickToOrder, Queued, EventDispatch::Queued)
+    ->UseManualTime()->Iterations(OrderingWorkflow::maxOrders);
+
+} // Namespace FixClientBenchmark
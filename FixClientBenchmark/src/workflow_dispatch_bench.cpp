@@ -0,0 +1,125 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// workflow_dispatch_bench.cpp
+// FixClientBenchmark
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <cstdint>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "fix_engine.hpp"
+
+#include "bench_messages.hpp"
+
+namespace FixClientBenchmark {
+
+  using namespace FixClient;
+
+  // -------- -------- -------- --------
+  // MARK: Workflows
+
+  // Cheap handlers so the dispatch itself shows up in the numbers
+  class CountingWorkflow : public WorkflowInterface
+  {
+    public:
+
+      CountingWorkflow() : WorkflowInterface("BENCH") {}
+
+      void onMarketData(
+        const std::vector<MarketDataModel>& model) const override
+      {
+        count_ += model.size();
+      }
+
+      void onSessionState(const SessionStateModel& model) const override
+      {
+        count_ += model.sessionState;
+      }
+
+      mutable std::uint64_t count_ { 0 };
+  };
+
+  // Same handlers, but `final` lets BasicFixEngine bind them statically
+  class StaticCountingWorkflow final : public CountingWorkflow
+  {
+  };
+
+  const FIX::SessionID trSession("FIX.4.4", "BENCH-TR", "OPENYIELD-TR");
+  const FIX::SessionID mdSession("FIX.4.4", "BENCH-MD", "OPENYIELD-MD");
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Session State
+
+  static void BM_DispatchSessionStateVirtual(benchmark::State& state)
+  {
+    auto message = tradingSessionStatus(FIX::TradSesStatus_OPEN);
+    auto workflow = std::make_shared<CountingWorkflow>();
+    FixEngine engine(workflow);
+
+    for (auto _ : state) {
+      engine.fromApp(message, trSession);
+    }
+
+    benchmark::DoNotOptimize(workflow->count_);
+  }
+
+  static void BM_DispatchSessionStateStatic(benchmark::State& state)
+  {
+    auto message = tradingSessionStatus(FIX::TradSesStatus_OPEN);
+    auto workflow = std::make_shared<StaticCountingWorkflow>();
+    BasicFixEngine<StaticCountingWorkflow> engine(workflow);
+
+    for (auto _ : state) {
+      engine.fromApp(message, trSession);
+    }
+
+    benchmark::DoNotOptimize(workflow->count_);
+  }
+
+  BENCHMARK(BM_DispatchSessionStateVirtual);
+  BENCHMARK(BM_DispatchSessionStateStatic);
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Market Data
+
+  static void BM_DispatchMarketDataVirtual(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(1);
+    auto workflow = std::make_shared<CountingWorkflow>();
+    FixEngine engine(workflow, MarketDataDecoder::Raw);
+
+    for (auto _ : state) {
+      engine.fromApp(message, mdSession);
+    }
+
+    benchmark::DoNotOptimize(workflow->count_);
+  }
+
+  static void BM_DispatchMarketDataStatic(benchmark::State& state)
+  {
+    auto message = incrementalRefresh(1);
+    auto workflow = std::make_shared<StaticCountingWorkflow>();
+    BasicFixEngine<StaticCountingWorkflow> engine(
+      workflow, MarketDataDecoder::Raw
+    );
+
+    for (auto _ : state) {
+      engine.fromApp(message, mdSession);
+    }
+
+    benchmark::DoNotOptimize(workflow->count_);
+  }
+
+  BENCHMARK(BM_DispatchMarketDataVirtual);
+  BENCHMARK(BM_DispatchMarketDataStatic);
+
+} // Namespace FixClientBenchmark
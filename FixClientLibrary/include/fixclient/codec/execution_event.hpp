@@ -36,9 +36,12 @@
 
 #include "log.hpp"
 #include "quickfix.hpp"
+#include "model/security_model.hpp"
 
 namespace FixClient {
 
+  class SecurityTable;
+
   // -------- -------- -------- -------- -------- -------- -------- --------
   // MARK: Acknowledge Event Model
   //
@@ -100,8 +103,11 @@ namespace FixClient {
     
     // ISIN or CUSIP (depending on setup)
     std::string securityCode;
+
+    // Interned securityCode
+    SecurityId securityId { noSecurityId };
         
-    // ATS Execution Code
+    // ATS Execution Code, up to 31 characters in the compact model
     std::string executionCode;
     
     // Who we will face
@@ -110,7 +116,8 @@ namespace FixClient {
     // Optionally a clearing account
     std::string contraClearingAccount;
     
-    // A reflected back code send by the subscriber
+    // A reflected back code send by the subscriber. MPIDs and accounts
+    // hold up to 15 characters in the compact model.
     std::string subscriberAccount;
 
     // Where it executed (for now always OYLD)
@@ -189,7 +196,7 @@ namespace FixClient {
   
   struct ExecutionEventModel
   {
-    // Against which order
+    // Against which order, up to 39 characters in the compact model
     std::string orderCode;
     
     // Payload
@@ -208,14 +215,29 @@ namespace FixClient {
   {
   
     public:
+
+      // Models get their SecurityId from the table, if there is one
+      explicit ExecutionEventCodec(SecurityTable* securities = nullptr);
     
       std::optional<ExecutionEventModel> onExecutionReport(
         const FIX44::ExecutionReport& message
       ) const;
 
+      // Overwrites event, reusing its strings while reports of the
+      // same kind follow each other. False for unhandled reports.
+      bool onExecutionReport(
+        const FIX44::ExecutionReport& message,
+        ExecutionEventModel& event
+      ) const;
+
     private:
     
       Log log_;
+
+      // Caps full message dumps during storms
+      mutable LogRateLimiter unhandledLimiter_ { 10 };
+
+      SecurityTable* securities_;
   
   };
 
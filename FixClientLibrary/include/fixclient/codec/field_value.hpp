@@ -0,0 +1,96 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// field_value.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Typed reads straight out of a QuickFIX field map. FieldMap::get()
+// copies the value into a field object first, these return the stored
+// string or convert it in place, so the codecs decode without touching
+// the heap. Missing fields throw FIX::FieldNotFound all the same.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "quickfix.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Field Values
+
+  inline const std::string& stringField(const FIX::FieldMap& fields,
+    int tag)
+  {
+    return fields.getField(tag);
+  }
+
+  inline double doubleField(const FIX::FieldMap& fields, int tag)
+  {
+    return FIX::DoubleConvertor::convert(fields.getField(tag));
+  }
+
+  inline int intField(const FIX::FieldMap& fields, int tag)
+  {
+    return FIX::IntConvertor::convert(fields.getField(tag));
+  }
+
+  inline char charField(const FIX::FieldMap& fields, int tag)
+  {
+    return FIX::CharConvertor::convert(fields.getField(tag));
+  }
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Reused Buffers
+
+  // Fills a caller's vector from the front, assigning over the models
+  // left from the previous message so their strings keep capacity
+  template <typename Model>
+  class ModelWriter
+  {
+
+    public:
+
+      explicit ModelWriter(std::vector<Model>& models) :
+        models_(models)
+      {
+        // Nada
+      }
+
+      void operator()(const Model& model)
+      {
+        if (count_ < models_.size()) {
+          models_[count_] = model;
+        } else {
+          models_.push_back(model);
+        }
+        ++count_;
+      }
+
+      // Drops what the previous message left over
+      void finish()
+      {
+        models_.resize(count_);
+      }
+
+    private:
+
+      std::vector<Model>& models_;
+
+      std::size_t count_ { 0 };
+
+  };
+
+} // Namespace FixClient
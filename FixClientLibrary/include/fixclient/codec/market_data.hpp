@@ -43,10 +43,14 @@
 
 #pragma once
 
+#include <concepts>
 #include <string>
 #include <vector>
 
 #include "quickfix.hpp"
+#include "codec/field_value.hpp"
+#include "model/security_model.hpp"
+#include "state/security_table.hpp"
 
 namespace FixClient {
 
@@ -73,8 +77,12 @@ namespace FixClient {
     //   const char MDEntryType_TRADING_SESSION_LOW_PRICE = '8';
     char entryType;
     
-    // FIX::SecurityID (ISIN or CUSIP as configured)
+    // FIX::SecurityID (ISIN or CUSIP as configured), up to 15
+    // characters in the compact model
     std::string securityCode;
+
+    // Interned securityCode
+    SecurityId securityId { noSecurityId };
     
     // FIX::MDEntrySize
     double quantity;
@@ -86,6 +94,8 @@ namespace FixClient {
     // NOTE: Standard FIX does not offer a Yield field in Market
     // data messages, so we chose the PriceDelta field.
     double yield;
+
+    bool operator==(const MarketDataModel&) const = default;
   
   };
 
@@ -96,6 +106,9 @@ namespace FixClient {
   {
   
     public:
+
+      // Models get their SecurityId from the table, if there is one
+      explicit MarketDataCodec(SecurityTable* securities = nullptr);
     
       std::vector<MarketDataModel> onMarketDataSnapshotFullRefresh(
         const FIX44::MarketDataSnapshotFullRefresh& message
@@ -105,8 +118,90 @@ namespace FixClient {
         const FIX44::MarketDataIncrementalRefresh& message
       ) const;
 
+      // Replace the content of data. Once it grew to the largest
+      // message, decoding does not allocate.
+      void onMarketDataSnapshotFullRefresh(
+        const FIX44::MarketDataSnapshotFullRefresh& message,
+        std::vector<MarketDataModel>& data
+      ) const;
+
+      void onMarketDataIncrementalRefresh(
+        const FIX44::MarketDataIncrementalRefresh& message,
+        std::vector<MarketDataModel>& data
+      ) const;
+
+      // Call sink(const MarketDataModel&) once per entry. The model is
+      // reused for the next entry.
+      template <typename Sink>
+        requires std::invocable<Sink&, const MarketDataModel&>
+      void onMarketDataSnapshotFullRefresh(
+        const FIX44::MarketDataSnapshotFullRefresh& message,
+        Sink&& sink
+      ) const;
+
+      template <typename Sink>
+        requires std::invocable<Sink&, const MarketDataModel&>
+      void onMarketDataIncrementalRefresh(
+        const FIX44::MarketDataIncrementalRefresh& message,
+        Sink&& sink
+      ) const;
+
     private:
+
+      SecurityTable* securities_;
   
   };
 
+  template <typename Sink>
+    requires std::invocable<Sink&, const MarketDataModel&>
+  void MarketDataCodec::onMarketDataSnapshotFullRefresh(
+    const FIX44::MarketDataSnapshotFullRefresh& message,
+    Sink&& sink) const
+  {
+    MarketDataModel model {};
+    model.action = FIX::MDUpdateAction_NEW;
+    model.securityCode = stringField(message, FIX::FIELD::SecurityID);
+    model.securityId = internSecurity(securities_, model.securityCode);
+
+    const int entries = intField(message, FIX::FIELD::NoMDEntries);
+
+    for (int i = 1; i <= entries; ++i) {
+      const FIX::FieldMap& group =
+        message.getGroupRef(i, FIX::FIELD::NoMDEntries);
+
+      model.entryType = charField(group, FIX::FIELD::MDEntryType);
+      model.price = doubleField(group, FIX::FIELD::MDEntryPx);
+      model.quantity = doubleField(group, FIX::FIELD::MDEntrySize);
+      model.yield = doubleField(group, FIX::FIELD::PriceDelta);
+
+      sink(static_cast<const MarketDataModel&>(model));
+    }
+  }
+
+  template <typename Sink>
+    requires std::invocable<Sink&, const MarketDataModel&>
+  void MarketDataCodec::onMarketDataIncrementalRefresh(
+    const FIX44::MarketDataIncrementalRefresh& message,
+    Sink&& sink) const
+  {
+    MarketDataModel model {};
+
+    const int entries = intField(message, FIX::FIELD::NoMDEntries);
+
+    for (int i = 1; i <= entries; ++i) {
+      const FIX::FieldMap& group =
+        message.getGroupRef(i, FIX::FIELD::NoMDEntries);
+
+      model.action = charField(group, FIX::FIELD::MDUpdateAction);
+      model.securityCode = stringField(group, FIX::FIELD::SecurityID);
+      model.securityId = internSecurity(securities_, model.securityCode);
+      model.entryType = charField(group, FIX::FIELD::MDEntryType);
+      model.price = doubleField(group, FIX::FIELD::MDEntryPx);
+      model.quantity = doubleField(group, FIX::FIELD::MDEntrySize);
+      model.yield = doubleField(group, FIX::FIELD::PriceDelta);
+
+      sink(static_cast<const MarketDataModel&>(model));
+    }
+  }
+
 } // Namespace FixClient
@@ -33,12 +33,16 @@
 #include <string>
 
 #include "quickfix.hpp"
+#include "model/security_model.hpp"
 
 namespace FixClient {
 
+  class SecurityTable;
+
 	struct IOIOrderModel
   {
-    // The IOIOrderCode being created, updated or canceled
+    // The IOIOrderCode being created, updated or canceled. The IOI book
+    // keys on it and ignores IOIs whose code is over 39 characters.
     std::string ioiCode;
     
     // Values are
@@ -47,8 +51,12 @@ namespace FixClient {
     //   Delete
     std::string action;
     
-    // FIX::SecurityID (ISIN or CUSIP as configured)
+    // FIX::SecurityID (ISIN or CUSIP as configured), up to 15
+    // characters in the compact model
     std::string securityCode;
+
+    // Interned securityCode
+    SecurityId securityId { noSecurityId };
     
     // Values are
     //   Bid
@@ -79,12 +87,23 @@ namespace FixClient {
   {
   
     public:
+
+      // Models get their SecurityId from the table, if there is one
+      explicit OrderBookCodec(SecurityTable* securities = nullptr);
     
       IOIOrderModel onIOI(
         const FIX44::IOI& message
       ) const;
 
+      // Overwrites model, reusing its strings
+      void onIOI(
+        const FIX44::IOI& message,
+        IOIOrderModel& model
+      ) const;
+
     private:
+
+      SecurityTable* securities_;
   
   };
 
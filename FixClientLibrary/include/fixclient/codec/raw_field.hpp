@@ -0,0 +1,167 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// raw_field.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  FIX Raw Field Reader                                         │░░
+//    │                                                               │░░
+//    │  - Walks a tag=value<SOH> buffer once                         │░░
+//    │  - Values are views into the buffer, nothing is copied        │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Used by the raw codecs to skip QuickFIX field maps and group copies.
+// The buffer must outlive every view handed out by the reader.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <string_view>
+
+#include "quickfix.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Raw Field
+
+  struct RawField
+  {
+    // FIX tag number
+    int tag;
+
+    // Everything between '=' and the SOH
+    std::string_view value;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Raw Field Reader
+
+  class RawFieldReader
+  {
+
+    public:
+
+      static constexpr char SOH = '\1';
+
+      explicit RawFieldReader(std::string_view buffer) :
+        buffer_(buffer)
+      {}
+
+      // Read the next field. Returns false at the end of the buffer or
+      // when the remaining bytes are not a complete tag=value<SOH>
+      inline bool next(RawField& field)
+      {
+        const char* cursor = buffer_.data() + position_;
+        const char* end = buffer_.data() + buffer_.size();
+
+        int tag = 0;
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+          tag = tag * 10 + (*cursor - '0');
+          ++cursor;
+        }
+
+        if (cursor >= end || *cursor != '=' || tag == 0) {
+          return false;
+        }
+        ++cursor;
+
+        const char* value = cursor;
+        while (cursor < end && *cursor != SOH) {
+          ++cursor;
+        }
+
+        if (cursor >= end) {
+          return false;
+        }
+
+        field.tag = tag;
+        field.value = std::string_view(value, cursor - value);
+        position_ = (cursor - buffer_.data()) + 1;
+
+        return true;
+      }
+
+    private:
+
+      std::string_view buffer_;
+      std::size_t position_ { 0 };
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Raw Value Conversion
+  //
+  // These throw the same FIX::IncorrectDataFormat QuickFIX would throw
+  // when a field fails to convert, so a bad message is rejected the
+  // same way on both decode paths.
+
+  inline int rawToInt(const RawField& field)
+  {
+    int value = 0;
+    const char* begin = field.value.data();
+    const char* end = begin + field.value.size();
+
+    auto [last, error] = std::from_chars(begin, end, value);
+    if (error != std::errc() || last != end) {
+      throw FIX::IncorrectDataFormat(field.tag, std::string(field.value));
+    }
+
+    return value;
+  }
+
+  inline char rawToChar(const RawField& field)
+  {
+    if (field.value.size() != 1) {
+      throw FIX::IncorrectDataFormat(field.tag, std::string(field.value));
+    }
+
+    return field.value.front();
+  }
+
+  inline double rawToDouble(const RawField& field)
+  {
+    double value = 0.0;
+    const char* begin = field.value.data();
+    const char* end = begin + field.value.size();
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto [last, error] = std::from_chars(begin, end, value);
+    if (error != std::errc() || last != end) {
+      throw FIX::IncorrectDataFormat(field.tag, std::string(field.value));
+    }
+#else
+    // libc++ has no floating point from_chars yet, copy to the stack
+    char text[64];
+    if (field.value.empty() || field.value.size() >= sizeof(text)) {
+      throw FIX::IncorrectDataFormat(field.tag, std::string(field.value));
+    }
+    field.value.copy(text, field.value.size());
+    text[field.value.size()] = '\0';
+
+    char* last = nullptr;
+    value = std::strtod(text, &last);
+    if (last != text + field.value.size()) {
+      throw FIX::IncorrectDataFormat(field.tag, std::string(field.value));
+    }
+#endif
+
+    return value;
+  }
+
+} // Namespace FixClient
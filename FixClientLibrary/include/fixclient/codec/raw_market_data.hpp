@@ -0,0 +1,83 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// raw_market_data.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  FIX Market Data (Raw)                                        │░░
+//    │                                                               │░░
+//    │  - Incremental Update decoded from the wire bytes             │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Produces exactly what MarketDataCodec::onMarketDataIncrementalRefresh
+// produces, but walks the tag=value buffer once instead of copying every
+// NoMDEntries group out of the QuickFIX field map.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "codec/market_data.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Market Data Decoder
+  //
+  // Selects how FixEngine decodes MarketDataIncrementalRefresh
+
+  enum class MarketDataDecoder {
+
+    // Crack into FIX44::MarketDataIncrementalRefresh and use
+    // MarketDataCodec
+    QuickFix,
+
+    // Walk the serialized message with RawMarketDataCodec
+    Raw
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Raw Market Data Codec
+
+  class RawMarketDataCodec
+  {
+
+    public:
+
+      // Models get their SecurityId from the table, if there is one
+      explicit RawMarketDataCodec(SecurityTable* securities = nullptr);
+
+      // The message is a full FIX message, header and trailer included
+      std::vector<MarketDataModel> onMarketDataIncrementalRefresh(
+        std::string_view message
+      ) const;
+
+      // Replaces the content of data, see MarketDataCodec
+      void onMarketDataIncrementalRefresh(
+        std::string_view message,
+        std::vector<MarketDataModel>& data
+      ) const;
+
+    private:
+
+      SecurityTable* securities_;
+
+  };
+
+} // Namespace FixClient
@@ -25,9 +25,12 @@
 
 #pragma once
 
+#include <concepts>
 #include <string>
+#include <vector>
 
 #include "quickfix.hpp"
+#include "codec/field_value.hpp"
 #include "../model/security_model.hpp"
 
 namespace FixClient {
@@ -44,8 +47,58 @@ namespace FixClient {
         const FIX44::SecurityList& message
       ) const;
 
+      // Replaces the content of data, reusing its models
+      void onSecurityList(
+        const FIX44::SecurityList& message,
+        std::vector<SecurityModel>& data
+      ) const;
+
+      // Calls sink(const SecurityModel&) once per security. The model
+      // is reused for the next one.
+      template <typename Sink>
+        requires std::invocable<Sink&, const SecurityModel&>
+      void onSecurityList(
+        const FIX44::SecurityList& message,
+        Sink&& sink
+      ) const;
+
     private:
   
   };
 
+  template <typename Sink>
+    requires std::invocable<Sink&, const SecurityModel&>
+  void SecurityCodec::onSecurityList(
+    const FIX44::SecurityList& message,
+    Sink&& sink) const
+  {
+    // Required, even if unused
+    stringField(message, FIX::FIELD::SecurityReqID);
+    stringField(message, FIX::FIELD::SecurityResponseID);
+
+    if (!message.isSetField(FIX::FIELD::NoRelatedSym)) {
+      return;
+    }
+
+    SecurityModel model {};
+
+    const int securities = intField(message, FIX::FIELD::NoRelatedSym);
+
+    for (int i = 1; i <= securities; ++i) {
+      const FIX::FieldMap& group =
+        message.getGroupRef(i, FIX::FIELD::NoRelatedSym);
+
+      stringField(group, FIX::FIELD::Symbol);
+      model.code = stringField(group, FIX::FIELD::SecurityID);
+      model.kind = (
+        stringField(group, FIX::FIELD::SecurityIDSource)
+          == FIX::SecurityIDSource_ISIN_NUMBER
+            ? SecurityCodeKind::ISIN
+            : SecurityCodeKind::CUSIP
+      );
+
+      sink(static_cast<const SecurityModel&>(model));
+    }
+  }
+
 } // Namespace FixClient
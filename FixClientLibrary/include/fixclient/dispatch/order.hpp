@@ -25,10 +25,14 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 
 #include "log.hpp"
 #include "quickfix.hpp"
+#include "dispatch/session_handle.hpp"
 #include "../model/security_model.hpp"
 
 namespace FixClient {
@@ -100,6 +104,30 @@ namespace FixClient {
     double price;
     
   };
+
+  // Quantity times price over 100, prices being a percentage of par.
+  // Market orders count at par.
+  inline double notionalOf(OrderKind kind, double quantity, double price)
+  {
+    if (kind == OrderKind::Market || price <= 0.0) {
+      return quantity;
+    }
+    return quantity * price / 100.0;
+  }
+
+  inline double notionalOf(const OrderModel& model)
+  {
+    return notionalOf(model.kind, model.quantity, model.price);
+  }
+
+  // See dispatch/risk_gate.hpp, dispatch/order_throttle.hpp and
+  // dispatch/replace_coalescer.hpp
+  class RiskGate;
+  struct RiskLimits;
+  enum class RiskCheck : std::uint8_t;
+  class OrderThrottle;
+  struct ThrottleLimits;
+  class ReplaceCoalescer;
   
   // -------- -------- -------- -------- -------- -------- -------- --------
   // MARK: Order Dispatch
@@ -110,8 +138,85 @@ namespace FixClient {
     
       // Construct an order dispatch with the FIX TR sender comp ID
       OrderDispatch(const std::string& senderCompId);
+
+      // Checks every order against limits before sending it
+      OrderDispatch(const std::string& senderCompId,
+        const RiskLimits& limits);
+
+      // And holds back orders past the venue's message rate
+      OrderDispatch(const std::string& senderCompId,
+        const RiskLimits& limits, const ThrottleLimits& throttle);
+
+      ~OrderDispatch();
     
-      void sendOrder(const OrderModel& model);
+      // Sends the order if the risk gate passes it, now or once the
+      // throttle lets it. exposureChange is what the order adds to the
+      // exposure of its security, the exposure limits only apply if it
+      // is given; tracked false fails Untracked. A full throttle queue
+      // fails MessageRate.
+      RiskCheck sendOrder(const OrderModel& model,
+        double exposureChange = 0.0, bool tracked = true);
+
+      RiskGate& risk()
+      {
+        return *risk_;
+      }
+
+      const RiskGate& risk() const
+      {
+        return *risk_;
+      }
+
+      const OrderThrottle& throttle() const
+      {
+        return *throttle_;
+      }
+
+      // Gets the orders the throttle queued whose send then threw, on
+      // the throttle's thread. sendOrder() had returned Passed for them,
+      // so the handler gives back what it reserved. Set it before
+      // sending.
+      void onQueuedSendFailed(
+        std::function<void(const OrderModel& model)> handler)
+      {
+        queuedSendFailed_ = std::move(handler);
+      }
+
+      // Holds replaces back while one is in flight. sendOrder() does
+      // not ask it, it needs the execution reports, see
+      // WorkflowInterface.
+      ReplaceCoalescer& replaces()
+      {
+        return *replaces_;
+      }
+
+      const ReplaceCoalescer& replaces() const
+      {
+        return *replaces_;
+      }
+
+      // The trading session orders go to, attached by the engine at
+      // logon, see SessionHolder
+      SessionHandle& session()
+      {
+        return session_;
+      }
+
+      const SessionHandle& session() const
+      {
+        return session_;
+      }
+
+      // The messages sendOrder() sends, without sending them
+      FIX44::NewOrderSingle newOrderMessage(const OrderModel& model) const;
+
+      FIX44::OrderCancelReplaceRequest replaceOrderMessage(
+        const OrderModel& model
+      ) const;
+
+      FIX44::OrderCancelReplaceRequest cancelOrderMessage(
+        const OrderModel& model
+      ) const;
       
       inline std::string senderCompId() const
       {
@@ -119,6 +224,8 @@ namespace FixClient {
       }
     
     private:
+
+      void send(const OrderModel& model);
     
       void sendNewOrder(const OrderModel& model);
       
@@ -128,6 +235,20 @@ namespace FixClient {
     
       std::string senderCompId_;
       Log log_;
+
+      SessionHandle session_;
+
+      std::unique_ptr<RiskGate> risk_;
+
+      std::unique_ptr<ReplaceCoalescer> replaces_;
+
+      // Caps the warnings for blocked orders
+      LogRateLimiter blockedLimiter_ { 10 };
+
+      std::function<void(const OrderModel& model)> queuedSendFailed_;
+
+      // Last, its thread sends through the members above
+      std::unique_ptr<OrderThrottle> throttle_;
     
   };
 
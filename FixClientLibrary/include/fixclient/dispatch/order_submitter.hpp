@@ -0,0 +1,162 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_submitter.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Order Submitter                                              │░░
+//    │                                                               │░░
+//    │  - Orders from any number of strategy threads                 │░░
+//    │  - Into a lock free queue, a ticket back right away           │░░
+//    │  - Sent one at a time by the submitter's thread               │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Strategy threads sending concurrently would each run the coalescer,
+// order cache, risk gate and throttle locks and the session's own. With
+// the submitter they only push onto an MpscQueue. Its thread sends the
+// orders in ticket order, so a replace or cancel submitted after the
+// order it changes is sent after it, whichever threads submitted them.
+//
+// Off, with capacity 0, submit() sends on the caller's thread and
+// nothing is timed.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "log.hpp"
+#include "dispatch/order.hpp"
+#include "metrics/latency_histogram.hpp"
+#include "queue/mpsc_queue.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Submission Ticket
+
+  struct SubmissionTicket
+  {
+    // Starts at 1 and grows by one per order taken. 0 if the queue was
+    // full and the order was not taken.
+    std::uint64_t sequence { 0 };
+
+    bool accepted() const
+    {
+      return sequence != 0;
+    }
+  };
+
+  // Sends one order on the submitter's thread, as
+  // WorkflowInterface::sendOrder
+  using OrderSubmission = std::function<RiskCheck(const OrderModel& model)>;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Order Submitter
+
+  class OrderSubmitter
+  {
+
+    public:
+
+      // Queued orders, rounded up to a power of two. 0 sends inline.
+      OrderSubmitter(std::size_t capacity, OrderSubmission send);
+
+      // Sends the orders still queued first
+      ~OrderSubmitter();
+
+      OrderSubmitter(const OrderSubmitter&) = delete;
+      OrderSubmitter& operator=(const OrderSubmitter&) = delete;
+
+      // Any thread, never blocks when on. Exceptions of the send are
+      // logged.
+      SubmissionTicket submit(const OrderModel& model);
+
+      // The ticket's order went through the send, blocked or not
+      bool done(const SubmissionTicket& ticket) const
+      {
+        return ticket.sequence <= completed_.load(std::memory_order_acquire);
+      }
+
+      // Orders sent but blocked by a risk check, or whose send threw
+      std::uint64_t blocked() const
+      {
+        return blocked_.load(std::memory_order_relaxed);
+      }
+
+      // Orders the queue was too full to take
+      std::uint64_t rejected() const
+      {
+        return rejected_.load(std::memory_order_relaxed);
+      }
+
+      // Nanoseconds from submit() until the send returned, with the
+      // order handed to the session or to the throttle's queue. Safe to
+      // read from any thread.
+      const LatencyHistogram& submitTime() const
+      {
+        return submitTime_;
+      }
+
+    private:
+
+      using Clock = std::chrono::steady_clock;
+
+      struct Submission
+      {
+        OrderModel model {};
+
+        Clock::time_point submittedAt {};
+      };
+
+      void run();
+
+      void sendOne(const Submission& submission, std::uint64_t sequence);
+
+      OrderSubmission send_;
+
+      // Null when off
+      std::unique_ptr<MpscQueue<Submission>> queue_;
+
+      // Bumped by every submit() and by the destructor, the thread
+      // sleeps on it when the queue is empty
+      std::atomic<std::uint32_t> signal_ { 0 };
+
+      std::atomic<bool> running_ { true };
+
+      // Sequence of the last order sent. Inline sends take theirs from
+      // it once sent.
+      std::atomic<std::uint64_t> completed_ { 0 };
+
+      std::atomic<std::uint64_t> blocked_ { 0 };
+      std::atomic<std::uint64_t> rejected_ { 0 };
+
+      // Recorded by the thread only
+      LatencyHistogram submitTime_;
+
+      Log log_;
+
+      // Last, it runs on the members above
+      std::thread thread_;
+
+  };
+
+} // Namespace FixClient
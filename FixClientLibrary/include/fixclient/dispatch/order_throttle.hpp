@@ -0,0 +1,178 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_throttle.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Order Throttle                                               │░░
+//    │                                                               │░░
+//    │  - Token bucket at the venue's message rate                   │░░
+//    │  - Queues what exceeds it, cancels before replaces before new │░░
+//    │  - Time spent queued per order action                         │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// One per OrderDispatch, so per trading session. The bucket holds up to
+// burst tokens and refills at messagesPerSecond. An order takes a token
+// and goes out on the caller's thread, or, when the bucket is empty or
+// orders are already waiting, joins the queue of its action. A thread
+// sends the queued orders as tokens come back, cancels first, then
+// replaces, then new orders, each queue in arrival order.
+//
+// A replace or cancel of an order still queued waits behind it, in its
+// queue, so it never reaches the venue before the order it changes.
+//
+// A queued send that throws is logged and handed to the failure
+// handler, which gives back what submitting the order had reserved.
+//
+// Sends are serialized under the throttle's lock. Off, with
+// messagesPerSecond 0, submit() sends right away and nothing is timed.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "log.hpp"
+#include "dispatch/order.hpp"
+#include "metrics/latency_histogram.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Throttle Limits
+
+  struct ThrottleLimits
+  {
+    // The venue's limit, 0 turns the throttle off
+    std::uint32_t messagesPerSecond { 0 };
+
+    // Messages sent back to back after a quiet spell, messagesPerSecond
+    // if 0
+    std::uint32_t burst { 0 };
+
+    // Orders waiting for a token, over all actions. Past it submit()
+    // refuses them.
+    std::size_t queueCapacity { 1024 };
+  };
+
+  enum class ThrottleResult : std::uint8_t {
+
+    Sent,
+
+    // Sent by the throttle's thread once a token is free
+    Queued,
+
+    // Not sent, the queue is full
+    QueueFull
+
+  };
+
+  // Sends one order, on the caller's thread or the throttle's
+  using OrderSender = std::function<void(const OrderModel& model)>;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Order Throttle
+
+  class OrderThrottle
+  {
+
+    public:
+
+      // failed gets the queued orders whose send threw
+      OrderThrottle(const ThrottleLimits& limits, OrderSender send,
+        OrderSender failed = {});
+
+      // Orders still queued are dropped, with a warning
+      ~OrderThrottle();
+
+      OrderThrottle(const OrderThrottle&) = delete;
+      OrderThrottle& operator=(const OrderThrottle&) = delete;
+
+      // Any thread. Exceptions of a send on the caller's thread reach
+      // the caller, those of queued sends are logged.
+      ThrottleResult submit(const OrderModel& model);
+
+      // Orders waiting for a token
+      std::size_t queued() const;
+
+      // Nanoseconds from submit() to the send, orders sent right away
+      // count as 0. Safe to read from any thread.
+      const LatencyHistogram& queuedTime(OrderAction action) const
+      {
+        return queuedTime_[static_cast<std::size_t>(action)];
+      }
+
+      const ThrottleLimits& limits() const
+      {
+        return limits_;
+      }
+
+    private:
+
+      using Clock = std::chrono::steady_clock;
+
+      struct QueuedOrder
+      {
+        OrderModel model;
+
+        Clock::time_point queuedAt;
+      };
+
+      // Under the lock. Adds the tokens earned since the last refill.
+      void refill(Clock::time_point now);
+
+      // Under the lock. The queue a model goes to, behind the order it
+      // replaces or cancels if that is still queued.
+      std::deque<QueuedOrder>& queueOf(const OrderModel& model);
+
+      // Under the lock. Cancels first, null if nothing is queued.
+      std::deque<QueuedOrder>* nextQueue();
+
+      void run();
+
+      const ThrottleLimits limits_;
+      const double capacity_;
+      OrderSender send_;
+      OrderSender failed_;
+
+      mutable std::mutex mutex_;
+      std::condition_variable wake_;
+
+      double tokens_;
+      Clock::time_point refilledAt_;
+
+      // By OrderAction, drained from Cancel down
+      std::array<std::deque<QueuedOrder>, 3> queues_;
+      std::size_t queued_ { 0 };
+
+      // By OrderAction, recorded under the lock
+      std::array<LatencyHistogram, 3> queuedTime_;
+
+      bool running_ { true };
+      std::thread thread_;
+
+      Log log_;
+
+  };
+
+} // Namespace FixClient
@@ -0,0 +1,144 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// replace_coalescer.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Replace Coalescer                                            │░░
+//    │                                                               │░░
+//    │  - One replace in flight per order                            │░░
+//    │  - Later replaces collapse into the latest one                │░░
+//    │  - Which goes out once the venue answered the first           │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// A replace sent while another replace of the same order waits for its
+// ack is held instead, and a newer one replaces the held one. Once the
+// venue acks or rejects the replace in flight, the held replace is sent
+// with originalOrderCode set to the ClOrdID the order then works under,
+// so each chain has at most one OrderCancelReplaceRequest on the wire.
+//
+// Replaces may name any ClOrdID of the chain as their original, held
+// ones included. The ClOrdIDs of replaces collapsed into a later one are
+// never sent. A cancel drops the held replace and goes out right away,
+// naming the replace in flight if it named a held one.
+//
+// Any thread. Chains are kept only while a replace is in flight, under
+// a lock; orders without one cost a lookup.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "log.hpp"
+#include "codec/execution_event.hpp"
+#include "dispatch/order.hpp"
+
+namespace FixClient {
+
+  enum class Coalesced : std::uint8_t {
+
+    // Send as is
+    Send,
+
+    // Send with the original order code given back
+    Rerouted,
+
+    // Not sent now. Goes out, or is collapsed into a later replace, once
+    // the replace in flight is answered.
+    Held
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Replace Coalescer
+
+  class ReplaceCoalescer
+  {
+
+    public:
+
+      // Before sending any replace or cancel. Rerouted sets
+      // originalOrderCode.
+      Coalesced submit(const OrderModel& model,
+        std::string& originalOrderCode);
+
+      // As execution reports arrive. True with the held replace to
+      // send now, when the report answered the replace in flight.
+      bool onExecution(const ExecutionEventModel& event,
+        OrderModel& amendment);
+
+      // Call if a replace submit() let through was not sent after all.
+      // A replace held behind it is dropped.
+      void onSendFailed(const OrderModel& model);
+
+      // Orders with a replace in flight
+      std::size_t inFlight() const;
+
+    private:
+
+      // Full codes, as the execution reports and the keys of chains_
+      // carry them
+      struct Chain
+      {
+        // The ClOrdID the order works under on the venue
+        std::string working;
+
+        // The replace waiting for its ack
+        std::string inFlight;
+
+        // The latest replace held back
+        bool hasAmendment { false };
+        OrderModel amendment {};
+
+        // Every ClOrdID mapped to the chain
+        std::vector<std::string> codes;
+      };
+
+      struct CodeHash
+      {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view code) const
+        {
+          return std::hash<std::string_view>{}(code);
+        }
+      };
+
+      void map(std::string_view code, const std::shared_ptr<Chain>& chain);
+
+      // Forgets the chain once nothing of it is in flight
+      void release(const Chain& chain);
+
+      mutable std::mutex mutex_;
+
+      std::unordered_map<std::string, std::shared_ptr<Chain>, CodeHash,
+        std::equal_to<>> chains_;
+
+      std::size_t inFlight_ { 0 };
+
+      Log log_;
+
+  };
+
+} // Namespace FixClient
@@ -0,0 +1,224 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// risk_gate.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Risk Gate                                                    │░░
+//    │                                                               │░░
+//    │  - Pre trade checks before an order leaves                    │░░
+//    │  - Order size, exposure, message rate and a kill switch       │░░
+//    │  - Blocks orders while the marketplace is closed or halted    │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// OrderDispatch asks the gate before sending. Every limit is an atomic
+// the check reads or reserves against, so strategy threads check
+// concurrently without a lock and a passed order never overshoots.
+//
+// Notional is as notionalOf() in order.hpp. Exposure is the notional
+// still working on the venue, per security and over all of them. It grows as
+// orders are sent and shrinks as the order cache sees them fill, cancel
+// or get rejected, see WorkflowInterface.
+//
+// Cancels only ever reduce risk, so the kill switch, the order limits
+// and the marketplace state never stop them. Every message counts
+// against the rate limit.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "log.hpp"
+#include "codec/session_state.hpp"
+#include "dispatch/order.hpp"
+#include "model/fixed_string.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Risk Limits
+
+  // 0 turns a limit off
+  struct RiskLimits
+  {
+    double maxOrderQuantity { 0.0 };
+
+    double maxOrderNotional { 0.0 };
+
+    double maxSecurityExposure { 0.0 };
+
+    double maxGrossExposure { 0.0 };
+
+    // New orders, replaces and cancels
+    std::uint32_t maxMessagesPerSecond { 0 };
+
+    // Distinct securities the exposure table has room for, orders in
+    // securities past it fail SecurityExposure
+    std::size_t securityCapacity { 4096 };
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Risk Check
+
+  // The first check an order failed, in the order they run
+  enum class RiskCheck : std::uint8_t {
+
+    Passed,
+
+    KillSwitch,
+
+    // The last SessionStateModel was Closed or Halted
+    MarketplaceClosed,
+
+    OrderQuantity,
+
+    OrderNotional,
+
+    // The order cache could not take the order, full or its ClOrdID
+    // too long, so its exposure would go unseen
+    Untracked,
+
+    SecurityExposure,
+
+    GrossExposure,
+
+    MessageRate
+
+  };
+
+  constexpr std::size_t riskCheckCount = 9;
+
+  std::string_view toString(RiskCheck value);
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Risk Gate
+
+  class RiskGate
+  {
+
+    public:
+
+      explicit RiskGate(const RiskLimits& limits = {});
+
+      // Any thread. Passed reserves exposureChange, what sending the
+      // order adds to the exposure of its security. Anything else
+      // reserves nothing. Orders other than cancels whose exposure is
+      // not tracked fail Untracked.
+      RiskCheck check(const OrderModel& model, double exposureChange,
+        bool tracked = true);
+
+      // Exposure the order cache saw go away, or come back after a
+      // post trade cancel. Never fails.
+      void adjust(std::string_view securityCode, double exposureChange);
+
+      // Blocks new orders and replaces until turned off
+      void setKillSwitch(bool engaged)
+      {
+        killSwitch_.store(engaged, std::memory_order_relaxed);
+      }
+
+      bool killSwitch() const
+      {
+        return killSwitch_.load(std::memory_order_relaxed);
+      }
+
+      // From the engine, as TradingSessionStatus messages arrive
+      void onSessionState(const SessionStateModel& model);
+
+      // Exposure of one security. Only kept with a security exposure
+      // limit, 0 otherwise.
+      double securityExposure(std::string_view securityCode) const;
+
+      double grossExposure() const
+      {
+        return grossExposure_.load(std::memory_order_relaxed);
+      }
+
+      // How many checks ended with result
+      std::uint64_t count(RiskCheck result) const
+      {
+        return counts_[static_cast<std::size_t>(result)].load(
+          std::memory_order_relaxed
+        );
+      }
+
+      const RiskLimits& limits() const
+      {
+        return limits_;
+      }
+
+    private:
+
+      // Claimed by a compare and swap of state, then published
+      struct ExposureSlot
+      {
+        // empty, claimed or ready
+        std::atomic<std::uint8_t> state { 0 };
+
+        SecurityCodeString securityCode;
+
+        std::atomic<double> exposure { 0.0 };
+      };
+
+      RiskCheck checkOrder(const OrderModel& model, double exposureChange,
+        bool tracked);
+
+      // Adds change unless it would pass limit, 0 being no limit
+      static bool reserve(std::atomic<double>& exposure, double change,
+        double limit);
+
+      static void add(std::atomic<double>& exposure, double change);
+
+      // Null if the code never had exposure
+      ExposureSlot* findSlot(std::string_view securityCode) const;
+
+      // Null once the table is full
+      ExposureSlot* insertSlot(std::string_view securityCode);
+
+      bool allowMessage();
+
+      const RiskLimits limits_;
+
+      std::atomic<bool> killSwitch_ { false };
+
+      std::atomic<bool> marketplaceClosed_ { false };
+
+      std::atomic<double> grossExposure_ { 0.0 };
+
+      // Power of two, only allocated with a security exposure limit
+      std::unique_ptr<ExposureSlot[]> securities_;
+      std::size_t securityMask_ { 0 };
+
+      // The current second in the high half, the messages sent in it in
+      // the low half, moved together by one compare and swap. Starts on
+      // a second that never comes.
+      std::atomic<std::uint64_t> messageWindow_ { ~std::uint64_t { 0 } };
+
+      std::array<std::atomic<std::uint64_t>, riskCheckCount> counts_ {};
+
+      // Caps the warning once the security table is full
+      LogRateLimiter fullLimiter_ { 1 };
+
+      Log log_;
+
+  };
+
+} // Namespace FixClient
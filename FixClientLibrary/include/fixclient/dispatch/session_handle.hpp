@@ -0,0 +1,84 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// session_handle.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  FIX Session Handle                                           │░░
+//    │                                                               │░░
+//    │  - The trading session, looked up once per logon              │░░
+//    │  - Sends straight to it while logged on                       │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Session::sendToTarget() builds a SessionID from the comp IDs and looks
+// it up in QuickFIX's session registry, under its lock, on every send.
+// The engine hands the handle its session at logon instead, and takes
+// it back at logout. In between, messages go to the session directly,
+// which fills in the header itself.
+//
+// QuickFIX keeps its sessions until the initiator is destroyed, so a
+// send racing a logout still reaches a live session, which stores the
+// message for resending as sendToTarget() would. Outside a logon the
+// handle falls back to sendToTarget().
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "quickfix.hpp"
+
+namespace FixClient {
+
+  class SessionHandle
+  {
+
+    public:
+
+      // The session between senderCompId, with its "-TR", and
+      // targetCompId
+      SessionHandle(const std::string& senderCompId,
+        const std::string& targetCompId = "OPENYIELD-TR");
+
+      // On the engine's logon and logout. Sessions of other comp IDs are
+      // ignored, false.
+      bool attach(const FIX::SessionID& sessionID);
+
+      bool detach(const FIX::SessionID& sessionID);
+
+      // Any thread. Throws FIX::SessionNotFound as sendToTarget() when
+      // not attached and QuickFIX does not know the session.
+      void send(FIX::Message& message) const;
+
+      bool attached() const
+      {
+        return session_.load(std::memory_order_acquire) != nullptr;
+      }
+
+    private:
+
+      bool matches(const FIX::SessionID& sessionID) const;
+
+      std::string senderCompId_;
+      std::string targetCompId_;
+
+      // Null outside a logon
+      std::atomic<FIX::Session*> session_ { nullptr };
+
+  };
+
+} // Namespace FixClient
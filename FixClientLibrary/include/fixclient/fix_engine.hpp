@@ -10,37 +10,62 @@
 // https://opensource.org/licenses/MIT.
 //
 // -------- -------- -------- -------- -------- -------- -------- --------
+//
+// The engine is a template on the workflow it calls into. The handlers
+// of the workflow type are bound at compile time, so a workflow declared
+// `final` (or one that does not derive from WorkflowInterface at all)
+// has its handlers inlined into the crack path.
+//
+// FixEngine is the runtime polymorphic version for workflows handed
+// over as a std::shared_ptr<WorkflowInterface>.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
 #include <variant>
 
 #include "log.hpp"
 #include "quickfix.hpp"
 #include "workflow.hpp"
 #include "codec/market_data.hpp"
+#include "codec/raw_market_data.hpp"
 #include "codec/session_state.hpp"
 #include "codec/execution_event.hpp"
 #include "codec/order_book.hpp"
+#include "codec/security_list.hpp"
+#include "journal/message_journal.hpp"
+#include "metrics/latency_metrics.hpp"
+#include "queue/event_queue.hpp"
+#include "queue/security_partitioner.hpp"
+#include "state/position_book.hpp"
+#include "state/security_table.hpp"
 
 namespace FixClient {
 
-  class FixEngine : public FIX::Application, public FIX44::MessageCracker
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Fix Engine Base
+  //
+  // The QuickFIX callbacks that never reach the workflow. Compiled once
+  // in the library for every engine type.
+
+  class FixEngineBase : public FIX::Application
   {
 
   public:
-  
-    FixEngine(std::shared_ptr<WorkflowInterface> workflow);
+
+    FixEngineBase(MarketDataDecoder marketDataDecoder,
+      const DispatchOptions& dispatch);
 
   // -------- -------- -------- -------- -------- -------- -------- --------
   // MARK: QuickFIX Boilerplate
 
     void onCreate(const FIX::SessionID& sessionID) override;
 
-    void onLogon(const FIX::SessionID& sessionID) override;
-
-    void onLogout(const FIX::SessionID& sessionID) override;
-
     void toAdmin(FIX::Message& message,
       const FIX::SessionID& sessionID) override;
 
@@ -51,15 +76,281 @@ namespace FixClient {
       const FIX::Message& message,
       const FIX::SessionID& sessionID) override;
 
+    // Every security code seen so far, seeded by the Security List.
+    // Models carry its SecurityIds.
+    const SecurityTable& securities() const
+    {
+      return securities_;
+    }
+
+    // Position, cost and cash per security and subscriber account,
+    // from every fill. Readable from any thread.
+    const PositionBook& positions() const
+    {
+      return positions_;
+    }
+
+    // Summed over the queues, zeros under inline dispatch
+    EventQueueStats eventQueueStats() const;
+
+    // The session's own queue under per session dispatch
+    EventQueueStats eventQueueStats(SessionRole role) const;
+
+    // Per message type and pipeline stage. Empty unless built with
+    // FIXCLIENT_LATENCY_METRICS.
+    std::vector<LatencySummary> latencySummaries() const;
+
+    // Appends every inbound application message to a MessageJournal at
+    // path, for replayJournal(). Call before QuickFIX starts. Throws
+    // std::system_error.
+    void journalTo(const std::string& path);
+
+  protected:
+
+    void journal(const FIX::Message& message,
+      const FIX::SessionID& sessionID);
+
+    // Cycle counter, or 0 when latency metrics are compiled out
+    static std::uint64_t latencyStamp()
+    {
+      if constexpr (latencyMetricsEnabled) {
+        return readCycles();
+      } else {
+        return 0;
+      }
+    }
+
+    // The writer is the queue index of the consumer recording, 0 on the
+    // QuickFIX threads
+    void recordLatency(LatencyMessage message, LatencyStage stage,
+      std::uint64_t start, std::size_t writer = 0)
+    {
+      if constexpr (latencyMetricsEnabled) {
+        latencyMetrics_->record(message, stage, latencyStamp() - start,
+          writer);
+      }
+    }
+
+    // Records the Crack stage, returns the stamp the codec starts at
+    std::uint64_t cracked(LatencyMessage message)
+    {
+      const std::uint64_t stamp = latencyStamp();
+      if constexpr (latencyMetricsEnabled) {
+        latencyMetrics_->record(message, LatencyStage::Crack,
+          stamp - receivedAt_);
+      }
+      return stamp;
+    }
+
+    void logUnsupportedMessage(const FIX::Message& message,
+      const FIX::SessionID& sessionID) const;
+
+    // The one queue, the session's under per session dispatch, the one
+    // after the workers under per security dispatch
+    EventQueue& queueOf(SessionRole role)
+    {
+      switch (dispatchMode_) {
+        case EventDispatch::PerSession:
+          return *eventQueues_[static_cast<std::size_t>(role)];
+
+        case EventDispatch::PerSecurity:
+          return *eventQueues_.back();
+
+        default:
+          return *eventQueues_.front();
+      }
+    }
+
+    // Splits the entries over the workers' queues
+    void dispatchBySecurity(const MarketDataEvent& event);
+
+    // Per worker under per security dispatch, so the workers share no
+    // state. Once otherwise.
+    struct SecurityBooks
+    {
+      explicit SecurityBooks(SecurityTable& securities) :
+        topOfBook(securities),
+        ioiBook(securities)
+      {
+        // Nada
+      }
+
+      // Best prices per security, kept for TopOfBookHandler workflows
+      TopOfBookTable topOfBook;
+
+      // Depth of book, kept for IOIBookHandler workflows
+      IOIBook ioiBook;
+    };
+
+    // The books a consumer thread works on
+    SecurityBooks& booksOf(std::size_t queue)
+    {
+      return *books_[queue < books_.size() ? queue : 0];
+    }
+
+    // A logger to print out what happened
+    Log log_;
+
+    // Caps unsupported message dumps during storms
+    mutable LogRateLimiter unsupportedLimiter_ { 10 };
+
+    // Caps journal failures once the disk is full
+    LogRateLimiter journalLimiter_ { 1 };
+
+    // Shared by the codecs and tables below, so declared first
+    SecurityTable securities_;
+
+    // Codecs
+    MarketDataCodec marketDataCodec_;
+    RawMarketDataCodec rawMarketDataCodec_;
+    SessionStateCodec sessionStateCodec_;
+    ExecutionEventCodec executionEventCodec_;
+    OrderBookCodec orderBookCodec_;
+    SecurityCodec securityCodec_;
+
+    // How incremental refreshes are decoded
+    MarketDataDecoder marketDataDecoder_;
+
+    std::vector<std::unique_ptr<SecurityBooks>> books_;
+
+    // Applied on the thread decoding execution reports
+    PositionBook positions_;
+
+    // Events for the consumer threads. None under inline dispatch,
+    // one per SessionRole under per session dispatch, one per worker
+    // and one for the rest under per security dispatch.
+    EventDispatch dispatchMode_;
+    SessionThreadLayout sessionThreads_;
+    std::vector<std::unique_ptr<EventQueue>> eventQueues_;
+
+    // Per security dispatch only, with the reused split buffers
+    SecurityPartitioner partitioner_;
+    std::vector<std::vector<MarketDataModel>> securityParts_;
+
+    // Null unless latency metrics are compiled in
+    std::unique_ptr<LatencyMetrics> latencyMetrics_;
+
+    // Null unless journalTo() was called
+    std::unique_ptr<MessageJournal> journal_;
+
+    // When fromApp got the message on this thread. Sessions may have
+    // their own QuickFIX threads, so not a member.
+    static inline thread_local std::uint64_t receivedAt_ { 0 };
+
+    // Reused serialization buffer for the raw decoder. Only the MD
+    // session delivers incrementals, so one thread touches it.
+    std::string rawMessage_;
+
+    // Reused decode buffers, so inline dispatch does not allocate once
+    // they grew. Queued dispatch moves them into the queue.
+    MarketDataEvent marketDataEvent_;
+    IOIOrderModel ioiOrder_;
+    ExecutionEventModel executionEvent_;
+    ExecutionEventModel notSent_;
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Basic Fix Engine
+
+  template <WorkflowHandler Workflow>
+  class BasicFixEngine :
+    public FixEngineBase,
+    public FIX44::MessageCracker
+  {
+
+  public:
+
+    BasicFixEngine(std::shared_ptr<Workflow> workflow,
+      MarketDataDecoder marketDataDecoder = MarketDataDecoder::QuickFix,
+      const DispatchOptions& dispatch = {}) :
+      FixEngineBase(marketDataDecoder, dispatch),
+      workflow_(workflow)
+    {
+      for (std::size_t i = 0; i < eventQueues_.size(); ++i) {
+        consumers_.emplace_back([this, i] { consume(i); });
+      }
+    }
+
+    // Delivers the queued events before returning
+    ~BasicFixEngine() override
+    {
+      for (std::unique_ptr<EventQueue>& queue : eventQueues_) {
+        queue->stop();
+      }
+      for (std::thread& consumer : consumers_) {
+        consumer.join();
+      }
+    }
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: QuickFIX Boilerplate
+
+    void onLogon(const FIX::SessionID& sessionID) override
+    {
+      log_.logDebug("[{}]/onLogon", sessionID.toStringFrozen());
+      if constexpr (SessionHolder<Workflow>) {
+        workflow_->attachSession(sessionID);
+      }
+      dispatch(SessionEvent {
+        .senderId = sessionID.getSenderCompID(),
+        .logon = true
+      });
+    }
+
+    void onLogout(const FIX::SessionID& sessionID) override
+    {
+      log_.logDebug("[{}]/onLogout", sessionID.toStringFrozen());
+      if constexpr (SessionHolder<Workflow>) {
+        workflow_->detachSession(sessionID);
+      }
+      dispatch(SessionEvent {
+        .senderId = sessionID.getSenderCompID(),
+        .logon = false
+      });
+    }
+
+    // Crack messages and pass them on to the handlers below. Rejects
+    // anything else!
     void fromApp(const FIX::Message& message,
-      const FIX::SessionID& sessionID) override;
+      const FIX::SessionID& sessionID) override
+    {
+      if (journal_) {
+        journal(message, sessionID);
+      }
+
+      receivedAt_ = latencyStamp();
+
+      // The raw decoder skips cracking for incrementals altogether
+      if ( marketDataDecoder_ == MarketDataDecoder::Raw
+        && message.getHeader().getField(FIX::FIELD::MsgType)
+          == FIX::MsgType_MarketDataIncrementalRefresh
+      ) {
+        message.toString(rawMessage_);
+        rawMarketDataCodec_.onMarketDataIncrementalRefresh(
+          rawMessage_,
+          marketDataEvent_.data
+        );
+        marketDataEvent_.snapshot = false;
+        recordLatency(LatencyMessage::MarketDataIncremental,
+          LatencyStage::Decode, receivedAt_);
+        dispatch(marketDataEvent_);
+        return;
+      }
+
+      try {
+        crack(message, sessionID);
+      } catch (FIX::UnsupportedMessageType& e) {
+        logUnsupportedMessage(message, sessionID);
+      }
+    }
 
   private:
-  
+
   // -------- -------- -------- -------- -------- -------- -------- --------
   // MARK: OPENYIELD-MD
-  
-  
+
+
     // -------- -------- -------- --------
     // MARK: Market Data Messages
 
@@ -70,9 +361,18 @@ namespace FixClient {
       [[ maybe_unused ]] const FIX::SessionID& session
     ) override
     {
-      workflow_->onMarketData(
-        marketDataCodec_.onMarketDataSnapshotFullRefresh(message)
+      const std::uint64_t crackedAt =
+        cracked(LatencyMessage::MarketDataSnapshot);
+
+      marketDataCodec_.onMarketDataSnapshotFullRefresh(
+        message,
+        marketDataEvent_.data
       );
+      marketDataEvent_.snapshot = true;
+
+      recordLatency(LatencyMessage::MarketDataSnapshot,
+        LatencyStage::Decode, crackedAt);
+      dispatch(marketDataEvent_);
     }
 
     // After the snapshot is done, any changes come as incremental
@@ -82,26 +382,38 @@ namespace FixClient {
       [[ maybe_unused ]] const FIX::SessionID& session
     ) override
     {
-      workflow_->onMarketData(
-        marketDataCodec_.onMarketDataIncrementalRefresh(message)
+      const std::uint64_t crackedAt =
+        cracked(LatencyMessage::MarketDataIncremental);
+
+      marketDataCodec_.onMarketDataIncrementalRefresh(
+        message,
+        marketDataEvent_.data
       );
+      marketDataEvent_.snapshot = false;
+
+      recordLatency(LatencyMessage::MarketDataIncremental,
+        LatencyStage::Decode, crackedAt);
+      dispatch(marketDataEvent_);
     }
 
   // -------- -------- -------- -------- -------- -------- -------- --------
   // MARK: OPENYIELD-OB
-  
-  
+
+
     // -------- -------- -------- --------
     // MARK: IOI Messages
-    
+
     void onMessage(
       const FIX44::IOI& message,
       [[ maybe_unused ]] const FIX::SessionID& session
     ) override
     {
-      workflow_->onOIOOrderBook(
-        orderBookCodec_.onIOI(message)
-      );
+      const std::uint64_t crackedAt = cracked(LatencyMessage::IOI);
+
+      orderBookCodec_.onIOI(message, ioiOrder_);
+
+      recordLatency(LatencyMessage::IOI, LatencyStage::Decode, crackedAt);
+      dispatch(ioiOrder_);
     }
 
   // -------- -------- -------- -------- -------- -------- -------- --------
@@ -113,8 +425,32 @@ namespace FixClient {
     void onMessage(
       const FIX44::ExecutionReport& message,
       [[ maybe_unused ]] const FIX::SessionID& session
-    ) override;
-  
+    ) override
+    {
+      const std::uint64_t crackedAt =
+        cracked(LatencyMessage::ExecutionReport);
+
+      if (executionEventCodec_.onExecutionReport(message, executionEvent_)) {
+        recordLatency(LatencyMessage::ExecutionReport,
+          LatencyStage::Decode, crackedAt);
+
+        // Here rather than in the handler, so the cache and positions
+        // are current while the event waits in a queue
+        bool notSent = false;
+        if constexpr (OrderStateHolder<Workflow>) {
+          notSent = workflow_->applyExecution(executionEvent_, notSent_);
+        }
+        positions_.apply(executionEvent_);
+
+        dispatch(executionEvent_);
+
+        // The held replace the report let go, blocked after all
+        if (notSent) {
+          dispatch(notSent_);
+        }
+      }
+    }
+
     // -------- -------- -------- --------
     // MARK: Session State Messages
 
@@ -123,26 +459,321 @@ namespace FixClient {
       [[ maybe_unused ]] const FIX::SessionID& session
     ) override
     {
-      workflow_->onSessionState(
-        sessionStateCodec_.onTradingSessionStatus(message)
-      );
+      const std::uint64_t crackedAt =
+        cracked(LatencyMessage::TradingSessionStatus);
+
+      SessionStateModel model =
+        sessionStateCodec_.onTradingSessionStatus(message);
+
+      recordLatency(LatencyMessage::TradingSessionStatus,
+        LatencyStage::Decode, crackedAt);
+
+      // The risk gate blocks orders as soon as the marketplace closes
+      if constexpr (OrderStateHolder<Workflow>) {
+        workflow_->applySessionState(model);
+      }
+      dispatch(std::move(model));
+    }
+
+    // -------- -------- -------- --------
+    // MARK: Security List Messages
+
+    // Answer to WorkflowInterface::requestSecurityList
+    void onMessage(
+      const FIX44::SecurityList& message,
+      [[ maybe_unused ]] const FIX::SessionID& session
+    ) override
+    {
+      const std::uint64_t crackedAt = cracked(LatencyMessage::SecurityList);
+
+      std::vector<SecurityModel> securities =
+        securityCodec_.onSecurityList(message);
+
+      // Before any later market data gets decoded
+      securities_.seed(securities);
+
+      recordLatency(LatencyMessage::SecurityList, LatencyStage::Decode,
+        crackedAt);
+
+      if constexpr (SecurityListHandler<Workflow>) {
+        dispatch(SecurityListEvent { .securities = std::move(securities) });
+      }
+    }
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Dispatch
+
+    // Runs the workflow right away, or moves the event into the queue
+    // of its session, or security, for a consumer thread
+    template <typename Event>
+    void dispatch(Event&& event)
+    {
+      using Type = std::remove_cvref_t<Event>;
+
+      if (eventQueues_.empty()) {
+        timedHandle(event, *books_.front(), 0);
+        return;
+      }
+
+      if (dispatchMode_ == EventDispatch::PerSecurity) {
+        if constexpr (std::is_same_v<Type, MarketDataEvent>) {
+          dispatchBySecurity(event);
+          return;
+        }
+
+        if constexpr (std::is_same_v<Type, IOIOrderModel>) {
+          const std::size_t worker =
+            partitioner_.workerOf(event.securityId, event.securityCode);
+          eventQueues_[worker]->push(WorkflowEvent { std::move(event) });
+          return;
+        }
+      }
+
+      queueOf(sessionRoleOf(event)).push(WorkflowEvent { std::move(event) });
+    }
+
+    void consume(std::size_t index)
+    {
+      EventQueue& queue = *eventQueues_[index];
+      SecurityBooks& books = booksOf(index);
+      const EventQueue* trading = nullptr;
+
+      if (dispatchMode_ == EventDispatch::PerSession) {
+        const auto role = static_cast<SessionRole>(index);
+        configureSessionThread(role, sessionThreads_[role]);
+
+        if (role != SessionRole::Trading) {
+          trading = &queueOf(SessionRole::Trading);
+        }
+      }
+
+      if ( dispatchMode_ == EventDispatch::PerSecurity
+        && index < partitioner_.workers()
+      ) {
+        trading = &queueOf(SessionRole::Trading);
+      }
+
+      WorkflowEvent event;
+      while (queue.pop(event)) {
+        // Market data and IOIs give way while trading events wait, for
+        // when the threads share cores
+        if (trading && !trading->empty()) {
+          std::this_thread::yield();
+        }
+
+        std::visit([this, &books, index](const auto& value) {
+          timedHandle(value, books, index);
+        }, event);
+      }
+    }
+
+    // The session an event came in on
+    static SessionRole sessionRoleOf(const SessionEvent& event)
+    {
+      return FixClient::sessionRoleOf(event.senderId);
+    }
+
+    static SessionRole sessionRoleOf(
+      [[ maybe_unused ]] const MarketDataEvent& event)
+    {
+      return SessionRole::MarketData;
+    }
+
+    static SessionRole sessionRoleOf(
+      [[ maybe_unused ]] const IOIOrderModel& model)
+    {
+      return SessionRole::OrderBook;
+    }
+
+    // Execution reports, session state and security lists
+    template <typename Event>
+    static SessionRole sessionRoleOf([[ maybe_unused ]] const Event& event)
+    {
+      return SessionRole::Trading;
+    }
+
+    // handle(), recorded as the Workflow stage of the event's message
+    // into the writer's histograms
+    template <typename Event>
+    void timedHandle(const Event& event, SecurityBooks& books,
+      [[ maybe_unused ]] std::size_t writer)
+    {
+      const std::uint64_t start = latencyStamp();
+
+      if constexpr (requires { handle(event, books); }) {
+        handle(event, books);
+      } else {
+        handle(event);
+      }
+
+      if constexpr (latencyMetricsEnabled) {
+        if (std::optional<LatencyMessage> message = latencyMessageOf(event)) {
+          recordLatency(message.value(), LatencyStage::Workflow, start,
+            writer);
+        }
+      }
+    }
+
+    static std::optional<LatencyMessage> latencyMessageOf(
+      const MarketDataEvent& event)
+    {
+      return event.snapshot
+        ? LatencyMessage::MarketDataSnapshot
+        : LatencyMessage::MarketDataIncremental;
+    }
+
+    static std::optional<LatencyMessage> latencyMessageOf(
+      [[ maybe_unused ]] const IOIOrderModel& model)
+    {
+      return LatencyMessage::IOI;
+    }
+
+    static std::optional<LatencyMessage> latencyMessageOf(
+      [[ maybe_unused ]] const ExecutionEventModel& model)
+    {
+      return LatencyMessage::ExecutionReport;
+    }
+
+    static std::optional<LatencyMessage> latencyMessageOf(
+      [[ maybe_unused ]] const SessionStateModel& model)
+    {
+      return LatencyMessage::TradingSessionStatus;
+    }
+
+    static std::optional<LatencyMessage> latencyMessageOf(
+      [[ maybe_unused ]] const SecurityListEvent& event)
+    {
+      return LatencyMessage::SecurityList;
+    }
+
+    // Logons, logouts and conflation markers
+    template <typename Event>
+    static std::optional<LatencyMessage> latencyMessageOf(
+      [[ maybe_unused ]] const Event& event)
+    {
+      return std::nullopt;
+    }
+
+    // -------- -------- -------- --------
+    // MARK: Event Handlers
+
+    void handle([[ maybe_unused ]] const ConflatedMarker& event)
+    {
+      // Nada
+    }
+
+    void handle(const SessionEvent& event)
+    {
+      if (event.logon) {
+        workflow_->onLogon(event.senderId);
+      } else {
+        workflow_->onLogout(event.senderId);
+      }
+    }
+
+    void handle(const MarketDataEvent& event,
+      [[ maybe_unused ]] SecurityBooks& books)
+    {
+      workflow_->onMarketData(event.data);
+
+      if constexpr (TopOfBookHandler<Workflow>) {
+        auto onChange = [this](const std::string& securityCode,
+          const TopOfBookModel& model)
+        {
+          workflow_->onTopOfBook(securityCode, model);
+        };
+
+        if (event.snapshot) {
+          books.topOfBook.applySnapshot(event.data, onChange);
+        } else {
+          books.topOfBook.applyIncremental(event.data, onChange);
+        }
+      }
+    }
+
+    void handle(const IOIOrderModel& model,
+      [[ maybe_unused ]] SecurityBooks& books)
+    {
+      workflow_->onOIOOrderBook(model);
+
+      if constexpr (IOIBookHandler<Workflow>) {
+        if (books.ioiBook.apply(model)) {
+          workflow_->onIOIBook(
+            model.securityCode,
+            *books.ioiBook.find(model.securityId)
+          );
+        }
+      }
+    }
+
+    void handle(const ExecutionEventModel& data)
+    {
+      if (std::holds_alternative<AcknowledgeEventModel>(data.value)) {
+        workflow_->onAcknowledgeEvent(
+          data.orderCode,
+          std::get<AcknowledgeEventModel>(data.value)
+        );
+        return;
+      }
+
+      if (std::holds_alternative<RejectEventModel>(data.value)) {
+        workflow_->onRejectEvent(
+          data.orderCode,
+          std::get<RejectEventModel>(data.value)
+        );
+        return;
+      }
+
+      if (std::holds_alternative<FillEventModel>(data.value)) {
+        workflow_->onFillEvent(
+          data.orderCode,
+          std::get<FillEventModel>(data.value)
+        );
+        return;
+      }
+
+      if (std::holds_alternative<PostTradeEventModel>(data.value)) {
+        workflow_->onPostTradeEvent(
+          data.orderCode,
+          std::get<PostTradeEventModel>(data.value)
+        );
+        return;
+      }
+
+      log_.logCritic("Unhandled Execution Event!");
+    }
+
+    void handle(const SessionStateModel& model)
+    {
+      workflow_->onSessionState(model);
+    }
+
+    void handle(const SecurityListEvent& event)
+    {
+      if constexpr (SecurityListHandler<Workflow>) {
+        workflow_->onSecurityList(event.securities);
+      }
     }
 
   // -------- -------- -------- -------- -------- -------- -------- --------
   // MARK: Private Properties
 
-    // A logger to print out what happened
-    Log log_;
-    
     // Override this to consume FIX data
-    std::shared_ptr<WorkflowInterface> workflow_;
-    
-    // Codecs
-    MarketDataCodec marketDataCodec_;
-    SessionStateCodec sessionStateCodec_;
-    ExecutionEventCodec executionEventCodec_;
-    OrderBookCodec orderBookCodec_;
+    std::shared_ptr<Workflow> workflow_;
+
+    // Run the workflow unless dispatch is inline
+    std::vector<std::thread> consumers_;
 
   };
 
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Fix Engine
+  //
+  // Virtual dispatch into any WorkflowInterface subclass. Instantiated
+  // once in the library.
+
+  using FixEngine = BasicFixEngine<WorkflowInterface>;
+
+  extern template class BasicFixEngine<WorkflowInterface>;
+
 } // Namespace FixClient
@@ -0,0 +1,64 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// journal_replay.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Feeds a MessageJournal back through an engine's fromApp, without a
+// counterparty. QuickFIX needs the FIX 4.4 data dictionary to parse
+// the repeating groups, the same FIX44.xml the sessions are configured
+// with.
+//
+// Whatever the workflow sends while replaying finds no session and is
+// lost.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "quickfix.hpp"
+#include "journal/message_journal.hpp"
+
+namespace FixClient {
+
+  enum class ReplayPace : std::uint8_t {
+
+    // Keeps the recorded gaps between messages, up to the replay's
+    // maxGap. The stamps are wall clock: a gap where the clock stepped
+    // back counts as none, and the downtime between two runs sharing a
+    // journal is cut to maxGap.
+    Recorded,
+
+    // Back to back
+    Max
+
+  };
+
+  struct ReplayStats
+  {
+    std::uint64_t messages { 0 };
+
+    // Did not parse, or fromApp threw
+    std::uint64_t failed { 0 };
+
+    std::chrono::nanoseconds elapsed { 0 };
+  };
+
+  // From the reader's position to the end of the journal
+  ReplayStats replayJournal(MessageJournalReader& reader,
+    FIX::Application& application,
+    const FIX::DataDictionary& dictionary,
+    ReplayPace pace = ReplayPace::Max,
+    std::chrono::nanoseconds maxGap = std::chrono::seconds(1));
+
+} // Namespace FixClient
@@ -0,0 +1,192 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// message_journal.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Message Journal                                              │░░
+//    │                                                               │░░
+//    │  - Append-only, memory mapped file of inbound FIX messages    │░░
+//    │  - Read back by MessageJournalReader and replayJournal()      │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// The file starts with a 64 byte header: the magic "OYJRNL01" and the
+// offset just past the last complete record. Records follow, each 8
+// byte aligned:
+//
+//   uint32  session ID length
+//   uint32  message length
+//   uint64  receive time, nanoseconds since the epoch
+//   bytes   session ID, as SessionID::toString()
+//   bytes   message, the raw FIX string
+//
+// Opening an existing journal continues after its last record, so a
+// restarted process never loses the journal of the previous run.
+//
+// Appending copies into the shared mapping and moves the end offset,
+// no system call unless the file has to grow. The pages reach the disk
+// whenever the OS writes them back, so the journal survives a crash of
+// the process but not of the machine.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "quickfix.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Journal Format
+
+  namespace JournalFormat {
+
+    inline constexpr char magic[8] = {
+      'O', 'Y', 'J', 'R', 'N', 'L', '0', '1'
+    };
+
+    inline constexpr std::size_t headerSize = 64;
+
+    // Offset of the end offset in the header
+    inline constexpr std::size_t endOffset = 8;
+
+    struct RecordHeader
+    {
+      std::uint32_t sessionLength;
+      std::uint32_t messageLength;
+      std::uint64_t receivedAt;
+    };
+
+    inline constexpr std::size_t align(std::size_t size)
+    {
+      return (size + 7) & ~std::size_t { 7 };
+    }
+
+  } // Namespace JournalFormat
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Message Journal
+
+  class MessageJournal
+  {
+
+    public:
+
+      // Creates the file, or appends to the journal already in it, and
+      // maps at least initialSize bytes of it. Throws std::system_error,
+      // or std::runtime_error rather than overwrite a file that is not
+      // a journal.
+      explicit MessageJournal(const std::string& path,
+        std::size_t initialSize = 64 * 1024 * 1024);
+
+      // Trims the file to its records
+      ~MessageJournal();
+
+      MessageJournal(const MessageJournal&) = delete;
+      MessageJournal& operator=(const MessageJournal&) = delete;
+
+      // Thread safe. False if the file could not grow, the record is
+      // then lost.
+      bool append(const FIX::Message& message,
+        const FIX::SessionID& sessionID,
+        std::uint64_t receivedAt);
+
+      bool append(std::string_view message, std::string_view sessionID,
+        std::uint64_t receivedAt);
+
+      // Bytes written, header included
+      std::size_t size() const;
+
+      // Nanoseconds since the epoch, the journal's receive time
+      static std::uint64_t now();
+
+    private:
+
+      // Mutex held
+      bool write(std::string_view message, std::string_view sessionID,
+        std::uint64_t receivedAt);
+
+      bool reserve(std::size_t bytes);
+
+      void map(std::size_t capacity);
+
+      // Leaves nothing mapped and capacity_ 0
+      void unmap();
+
+      mutable std::mutex mutex_;
+
+      int fd_ { -1 };
+      char* data_ { nullptr };
+      std::size_t capacity_ { 0 };
+      std::size_t end_ { JournalFormat::headerSize };
+
+      // Reused to serialize FIX::Message
+      std::string message_;
+      std::string sessionID_;
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Message Journal Reader
+
+  struct JournalRecord
+  {
+    std::uint64_t receivedAt;
+
+    // Point into the mapping, valid as long as the reader
+    std::string_view sessionID;
+    std::string_view message;
+  };
+
+  class MessageJournalReader
+  {
+
+    public:
+
+      // Maps the file read only. Throws std::system_error, or
+      // std::runtime_error if it is not a journal.
+      explicit MessageJournalReader(const std::string& path);
+
+      ~MessageJournalReader();
+
+      MessageJournalReader(const MessageJournalReader&) = delete;
+      MessageJournalReader& operator=(const MessageJournalReader&) = delete;
+
+      // False after the last complete record
+      bool next(JournalRecord& record);
+
+      void rewind()
+      {
+        position_ = JournalFormat::headerSize;
+      }
+
+    private:
+
+      int fd_ { -1 };
+      const char* data_ { nullptr };
+      std::size_t size_ { 0 };
+
+      std::size_t end_ { 0 };
+      std::size_t position_ { JournalFormat::headerSize };
+
+  };
+
+} // Namespace FixClient
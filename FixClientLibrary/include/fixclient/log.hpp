@@ -10,50 +10,185 @@
 // https://opensource.org/licenses/MIT.
 //
 // -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Log calls are asynchronous, see log_backend.hpp. With arguments, the
+// format string is checked at compile time and formatted on the
+// backend thread:
+//
+//   log_.logDebug("[{}]/toAdmin: {}", sessionID.toStringFrozen(),
+//     FixMessageText { message });
+//
+// Levels below FIXCLIENT_LOG_LEVEL (0 Debug ... 4 Critic) compile to
+// nothing, arguments included.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
 
 #pragma once
 
-#ifdef SCAFFOLD
-  #include <core/log/log.hpp>
-#else
-  #include <iostream>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <fmt/core.h>
+
+#include "log_backend.hpp"
+
+#ifndef FIXCLIENT_LOG_LEVEL
+  #define FIXCLIENT_LOG_LEVEL 0
 #endif
 
+namespace FIX {
+
+  class Message;
+
+} // Namespace FIX
+
 namespace FixClient {
 
+  // Checked against the types the backend formats
+  template <typename... Args>
+  using LogFormatString = fmt::format_string<
+    LogDetail::Decoded<std::remove_cvref_t<Args>>...
+  >;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Log
+
   class Log {
 
   public:
 
-    inline void logDebug(const std::string_view& logMessage) const
+    static constexpr LogLevel minimumLevel =
+      static_cast<LogLevel>(FIXCLIENT_LOG_LEVEL);
+
+    static constexpr bool isEnabled(LogLevel level)
+    {
+      return level >= minimumLevel;
+    }
+
+    inline void logDebug(std::string_view logMessage) const
+    {
+      logText<LogLevel::Debug>(logMessage);
+    }
+
+    template <typename Arg, typename... Args>
+    inline void logDebug(LogFormatString<Arg, Args...> format,
+      Arg&& arg, Args&&... args) const
+    {
+      logFormat<LogLevel::Debug>(format, arg, args...);
+    }
+
+    inline void logInfo(std::string_view logMessage) const
+    {
+      logText<LogLevel::Info>(logMessage);
+    }
+
+    template <typename Arg, typename... Args>
+    inline void logInfo(LogFormatString<Arg, Args...> format,
+      Arg&& arg, Args&&... args) const
+    {
+      logFormat<LogLevel::Info>(format, arg, args...);
+    }
+
+    inline void logWarning(std::string_view logMessage) const
+    {
+      logText<LogLevel::Warning>(logMessage);
+    }
+
+    template <typename Arg, typename... Args>
+    inline void logWarning(LogFormatString<Arg, Args...> format,
+      Arg&& arg, Args&&... args) const
+    {
+      logFormat<LogLevel::Warning>(format, arg, args...);
+    }
+
+    inline void logError(std::string_view logMessage) const
     {
-      log("DEBUG", logMessage);
+      logText<LogLevel::Error>(logMessage);
     }
 
-    inline void logInfo(const std::string_view& logMessage) const
+    template <typename Arg, typename... Args>
+    inline void logError(LogFormatString<Arg, Args...> format,
+      Arg&& arg, Args&&... args) const
     {
-      log("INFO", logMessage);
+      logFormat<LogLevel::Error>(format, arg, args...);
     }
 
-    inline void logWarning(const std::string_view& logMessage) const
+    inline void logCritic(std::string_view logMessage) const
     {
-      log("WARNING", logMessage);
+      logText<LogLevel::Critic>(logMessage);
     }
 
-    inline void logError(const std::string_view& logMessage) const
+    template <typename Arg, typename... Args>
+    inline void logCritic(LogFormatString<Arg, Args...> format,
+      Arg&& arg, Args&&... args) const
     {
-      log("ERROR", logMessage);
+      logFormat<LogLevel::Critic>(format, arg, args...);
     }
 
-    inline void logCritic(const std::string_view& logMessage) const
+    // Blocks until everything logged so far, by any thread, is written
+    static void flush();
+
+  private:
+
+    template <LogLevel Level>
+    void logText(std::string_view logMessage) const
     {
-      log("CRITIC", logMessage);
+      if constexpr (isEnabled(Level)) {
+        LogBackend::instance().push(Level, logMessage);
+      }
     }
 
+    template <LogLevel Level, typename... Args>
+    void logFormat(fmt::string_view format, const Args&... args) const
+    {
+      if constexpr (isEnabled(Level)) {
+        LogBackend::instance().push(Level, format, args...);
+      }
+    }
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Fix Message Text
+
+  // Log argument for a whole FIX message. Serialized only if the level
+  // is enabled, SOH delimiters are replaced on the backend thread.
+  struct FixMessageText
+  {
+    const FIX::Message& message;
+
+    void renderTo(std::string& text) const;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Log Rate Limiter
+
+  // At most maxPerSecond calls to allow() return true per second.
+  // Meant for full message dumps that can flood the log in a storm.
+  class LogRateLimiter {
+
+  public:
+
+    explicit LogRateLimiter(std::uint32_t maxPerSecond);
+
+    bool allow();
+
+    // How many calls were refused since the last call
+    std::uint64_t takeSuppressed();
+
   private:
 
-    void log(const std::string logLevel,
-      const std::string_view& logMessage) const;
+    const std::uint32_t maxPerSecond_;
+
+    // The current second in the high half, the calls allowed in it in
+    // the low half, moved together by one compare and swap. Starts on
+    // a second that never comes.
+    std::atomic<std::uint64_t> window_ { ~std::uint64_t { 0 } };
+
+    std::atomic<std::uint64_t> suppressed_ { 0 };
 
   };
 
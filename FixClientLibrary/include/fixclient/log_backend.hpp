@@ -0,0 +1,387 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// log_backend.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Asynchronous Log Backend                                     │░░
+//    │                                                               │░░
+//    │  - One lock-free ring buffer per logging thread               │░░
+//    │  - Arguments are copied, formatting happens on the backend    │░░
+//    │  - Output is written and flushed in batches                   │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// A logging thread never blocks and never waits for I/O. When its ring
+// is full the record is dropped and counted, the backend reports the
+// count. Records of different threads are not ordered against each
+// other.
+//
+// Use Log from log.hpp, not this file directly.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Log Level
+
+  enum class LogLevel : std::uint8_t {
+
+    Debug,
+
+    Info,
+
+    Warning,
+
+    Error,
+
+    Critic
+
+  };
+
+  namespace LogDetail {
+
+    // -------- -------- -------- --------
+    // MARK: Records
+
+    // Turns the payload of a record back into text
+    using FormatFunction = void (*)(
+      std::string_view format,
+      const char* payload,
+      fmt::memory_buffer& out
+    );
+
+    struct RecordHeader
+    {
+      // Header and payload, in bytes, before alignment
+      std::uint32_t size;
+
+      LogLevel level;
+
+      // Null when the payload is already the text
+      FormatFunction format;
+
+      // Points at the format string literal
+      const char* formatData;
+
+      std::uint32_t formatSize;
+    };
+
+    // Text whose FIX SOH delimiters are shown as spaces
+    struct FixText
+    {
+      std::string_view text;
+    };
+
+    // -------- -------- -------- --------
+    // MARK: Argument Capture
+    //
+    // Strings are copied by value, trivially copyable values byte for
+    // byte. Types with renderTo(std::string&) are rendered on the
+    // calling thread and shown as FixText.
+
+    template <typename T>
+    concept Renderable = requires(const T& value, std::string& text) {
+      value.renderTo(text);
+    };
+
+    template <typename T>
+    concept StringLike = std::is_convertible_v<const T&, std::string_view>;
+
+    template <typename T>
+    using Decoded = std::conditional_t<
+      Renderable<T>,
+      FixText,
+      std::conditional_t<StringLike<T>, std::string_view, T>
+    >;
+
+    inline void encodeText(std::string& out, std::string_view text)
+    {
+      std::uint32_t size = static_cast<std::uint32_t>(text.size());
+      out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+      out.append(text);
+    }
+
+    template <typename T>
+    void encode(std::string& out, const T& value)
+    {
+      if constexpr (Renderable<T>) {
+        thread_local std::string scratch;
+        value.renderTo(scratch);
+        encodeText(out, scratch);
+      } else if constexpr (StringLike<T>) {
+        encodeText(out, std::string_view(value));
+      } else {
+        static_assert(
+          std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>,
+          "Log arguments must be strings or trivially copyable values"
+        );
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+    }
+
+    template <typename T>
+    Decoded<T> decode(const char*& cursor)
+    {
+      if constexpr (Renderable<T> || StringLike<T>) {
+        std::uint32_t size;
+        std::memcpy(&size, cursor, sizeof(size));
+        std::string_view text(cursor + sizeof(size), size);
+        cursor += sizeof(size) + size;
+
+        if constexpr (Renderable<T>) {
+          return FixText { text };
+        } else {
+          return text;
+        }
+      } else {
+        T value;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+      }
+    }
+
+    template <typename... Args>
+    void formatRecord(
+      std::string_view format,
+      const char* payload,
+      fmt::memory_buffer& out)
+    {
+      // Braced initialization decodes left to right
+      const char* cursor = payload;
+      std::tuple<Decoded<Args>...> values { decode<Args>(cursor)... };
+
+      std::apply(
+        [&](auto&... value) {
+          fmt::vformat_to(
+            std::back_inserter(out),
+            fmt::string_view(format.data(), format.size()),
+            fmt::make_format_args(value...)
+          );
+        },
+        values
+      );
+    }
+
+    // -------- -------- -------- --------
+    // MARK: Ring
+
+    // Records start on 8 byte boundaries of the ring
+    constexpr std::size_t alignRecord(std::size_t size)
+    {
+      return (size + 7) & ~std::size_t(7);
+    }
+
+    // Single producer, single consumer ring of variable sized records.
+    // A record never wraps, the producer pads to the end instead.
+    class Ring
+    {
+
+      public:
+
+        // Capacity is a power of two
+        explicit Ring(std::size_t capacity);
+
+        // Producer side. Returns false and counts a drop when full.
+        bool push(const RecordHeader& header, std::string_view payload);
+
+        // Consumer side. Calls onRecord(header, payload) for everything
+        // published so far and returns how many records it saw.
+        template <typename OnRecord>
+        std::size_t drain(OnRecord&& onRecord);
+
+        bool empty() const
+        {
+          return head_.load(std::memory_order_acquire)
+            == tail_.load(std::memory_order_acquire);
+        }
+
+        std::uint64_t takeDropped()
+        {
+          return dropped_.exchange(0, std::memory_order_relaxed);
+        }
+
+        // Set when the owning thread exits
+        std::atomic<bool> abandoned { false };
+
+      private:
+
+        static constexpr std::uint32_t padding = 0xFFFFFFFF;
+
+        std::unique_ptr<char[]> buffer_;
+        std::size_t capacity_;
+
+        alignas(64) std::atomic<std::uint64_t> head_ { 0 };
+        alignas(64) std::atomic<std::uint64_t> tail_ { 0 };
+
+        // Producer's last view of head_
+        std::uint64_t cachedHead_ { 0 };
+        std::atomic<std::uint64_t> dropped_ { 0 };
+
+    };
+
+    template <typename OnRecord>
+    std::size_t Ring::drain(OnRecord&& onRecord)
+    {
+      std::uint64_t head = head_.load(std::memory_order_relaxed);
+      const std::uint64_t tail = tail_.load(std::memory_order_acquire);
+      std::size_t records = 0;
+
+      while (head < tail) {
+        const std::size_t position = head & (capacity_ - 1);
+        const std::size_t remaining = capacity_ - position;
+
+        std::uint32_t size = padding;
+        if (remaining >= sizeof(size)) {
+          std::memcpy(&size, buffer_.get() + position, sizeof(size));
+        }
+
+        if (size == padding) {
+          head += remaining;
+          continue;
+        }
+
+        RecordHeader header;
+        std::memcpy(&header, buffer_.get() + position, sizeof(header));
+        onRecord(
+          header,
+          std::string_view(
+            buffer_.get() + position + sizeof(header),
+            header.size - sizeof(header)
+          )
+        );
+
+        head += alignRecord(size);
+        ++records;
+      }
+
+      head_.store(head, std::memory_order_release);
+      return records;
+    }
+
+  } // Namespace LogDetail
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Log Backend
+
+  class LogBackend
+  {
+
+    public:
+
+      // Started on first use, never destroyed. Everything logged is
+      // flushed when the process exits normally.
+      static LogBackend& instance();
+
+      void push(LogLevel level, std::string_view text);
+
+      template <typename... Args>
+      void push(LogLevel level, fmt::string_view format,
+        const Args&... args);
+
+      // Blocks until everything logged before the call is written
+      void flush();
+
+      // Bytes per thread ring, for threads that have not logged yet
+      void setRingCapacity(std::size_t capacity);
+
+    private:
+
+      LogBackend();
+
+      LogDetail::Ring& ring();
+
+      void run();
+
+      std::size_t drainAll(fmt::memory_buffer& line);
+
+      void write(LogLevel level, std::string_view text);
+
+      void flushOutput();
+
+      std::mutex mutex_;
+      std::condition_variable wake_;
+      std::condition_variable flushed_;
+      std::vector<std::shared_ptr<LogDetail::Ring>> rings_;
+
+      // Backend thread's copy of rings_
+      std::vector<std::shared_ptr<LogDetail::Ring>> draining_;
+      std::atomic<std::size_t> ringCapacity_ { 256 * 1024 };
+
+      std::uint64_t flushRequested_ { 0 };
+      std::uint64_t flushCompleted_ { 0 };
+
+      std::thread thread_;
+
+  };
+
+  template <typename... Args>
+  void LogBackend::push(LogLevel level, fmt::string_view format,
+    const Args&... args)
+  {
+    // Reused per thread, so steady state logging does not allocate
+    thread_local std::string payload;
+    payload.clear();
+    (LogDetail::encode(payload, args), ...);
+
+    LogDetail::RecordHeader header {
+      .size = 0,
+      .level = level,
+      .format = &LogDetail::formatRecord<Args...>,
+      .formatData = format.data(),
+      .formatSize = static_cast<std::uint32_t>(format.size())
+    };
+
+    ring().push(header, payload);
+  }
+
+} // Namespace FixClient
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: FixText Formatter
+
+template <>
+struct fmt::formatter<FixClient::LogDetail::FixText> :
+  fmt::formatter<fmt::string_view>
+{
+  auto format(const FixClient::LogDetail::FixText& value,
+    fmt::format_context& context) const -> decltype(context.out())
+  {
+    auto out = context.out();
+    for (char character : value.text) {
+      *out++ = (character == '\1' ? ' ' : character);
+    }
+    return out;
+  }
+};
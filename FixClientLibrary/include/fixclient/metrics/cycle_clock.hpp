@@ -0,0 +1,56 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// cycle_clock.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// The cheapest timestamp the CPU offers: the TSC on x86, the virtual
+// counter on ARM64, steady_clock nanoseconds elsewhere. Only differences
+// between two readings on the same machine mean anything, convert them
+// with nanosecondsPerCycle().
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+#endif
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Cycle Clock
+
+  inline std::uint64_t readCycles()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t cycles;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(cycles));
+    return cycles;
+#else
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+      ).count()
+    );
+#endif
+  }
+
+  // Measured against steady_clock on the first call, which takes about
+  // 10 ms
+  double nanosecondsPerCycle();
+
+} // Namespace FixClient
@@ -0,0 +1,106 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// latency_histogram.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// HDR style histogram: every power of two is split into 8 linear
+// buckets, so a percentile is off by at most 12.5% over the whole
+// 64 bit range, in 4 KB of counters.
+//
+// One thread records, any thread may read. A reader sees counts at
+// most a few records behind.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Latency Histogram
+
+  class LatencyHistogram
+  {
+
+    public:
+
+      // Values below are counted exactly
+      static constexpr unsigned linearBits = 4;
+
+      static constexpr std::size_t bucketCount =
+        ((64 - linearBits) << (linearBits - 1)) + (1 << linearBits);
+
+      // Single writer
+      void record(std::uint64_t value)
+      {
+        increment(counts_[bucketOf(value)]);
+        increment(count_);
+
+        if (value > max_.load(std::memory_order_relaxed)) {
+          max_.store(value, std::memory_order_relaxed);
+        }
+      }
+
+      std::uint64_t count() const
+      {
+        return count_.load(std::memory_order_relaxed);
+      }
+
+      std::uint64_t max() const
+      {
+        return max_.load(std::memory_order_relaxed);
+      }
+
+      // Highest value of the bucket holding the given fraction of the
+      // values, 0.99 for p99. Never above max().
+      std::uint64_t percentile(double fraction) const;
+
+      // Adds the values of other, live or not, to this histogram. Not
+      // safe while this one is recorded into.
+      void merge(const LatencyHistogram& other);
+
+      static std::size_t bucketOf(std::uint64_t value)
+      {
+        if (value < (std::uint64_t { 1 } << linearBits)) {
+          return static_cast<std::size_t>(value);
+        }
+
+        const unsigned shift = std::bit_width(value) - linearBits;
+        return (static_cast<std::size_t>(shift) << (linearBits - 1))
+          + static_cast<std::size_t>(value >> shift);
+      }
+
+      static std::uint64_t highestOf(std::size_t bucket);
+
+    private:
+
+      static void increment(std::atomic<std::uint64_t>& counter)
+      {
+        counter.store(
+          counter.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed
+        );
+      }
+
+      std::array<std::atomic<std::uint64_t>, bucketCount> counts_ {};
+
+      std::atomic<std::uint64_t> count_ { 0 };
+      std::atomic<std::uint64_t> max_ { 0 };
+
+  };
+
+} // Namespace FixClient
@@ -0,0 +1,161 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// latency_metrics.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Latency Metrics                                              │░░
+//    │                                                               │░░
+//    │  - Cycles per inbound pipeline stage and message type         │░░
+//    │  - Reported as p50, p99, p99.9 and max in nanoseconds         │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// The engine stamps each inbound message with readCycles() as it goes
+// through fromApp, QuickFIX's crack, the codec and the workflow, and
+// records the differences here. Off unless built with
+// FIXCLIENT_LATENCY_METRICS=1 (cmake -DFIXCLIENT_LATENCY_METRICS=ON),
+// in which case the stamps compile to nothing.
+//
+// Each histogram has one writer. Each message type arrives on one
+// session, so the Crack and Decode stages are recorded by the session's
+// QuickFIX thread. The Workflow stage is recorded by whichever thread
+// handles the event, and under per security dispatch the workers all
+// handle market data and IOIs. So each writer, a consumer's queue
+// index, gets its own set of histograms, added up by summaries().
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "metrics/cycle_clock.hpp"
+#include "metrics/latency_histogram.hpp"
+
+#ifndef FIXCLIENT_LATENCY_METRICS
+  #define FIXCLIENT_LATENCY_METRICS 0
+#endif
+
+namespace FixClient {
+
+  inline constexpr bool latencyMetricsEnabled = FIXCLIENT_LATENCY_METRICS;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Latency Keys
+
+  enum class LatencyMessage : std::uint8_t {
+
+    MarketDataSnapshot,
+
+    MarketDataIncremental,
+
+    IOI,
+
+    ExecutionReport,
+
+    TradingSessionStatus,
+
+    SecurityList
+
+  };
+
+  inline constexpr std::size_t latencyMessageCount = 6;
+
+  enum class LatencyStage : std::uint8_t {
+
+    // fromApp to the onMessage overload, QuickFIX's type dispatch.
+    // QuickFIX parses the message before fromApp, out of our sight.
+    Crack,
+
+    // The codec, into the engine's buffers. With the raw decoder this
+    // starts at fromApp and includes serializing the message.
+    Decode,
+
+    // The workflow handlers, on the consumer thread under queued
+    // dispatch
+    Workflow
+
+  };
+
+  inline constexpr std::size_t latencyStageCount = 3;
+
+  std::string_view toString(LatencyMessage message);
+
+  std::string_view toString(LatencyStage stage);
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Latency Summary
+
+  // Nanoseconds
+  struct LatencySummary
+  {
+    LatencyMessage message;
+    LatencyStage stage;
+
+    std::uint64_t count;
+
+    double p50;
+    double p99;
+    double p999;
+    double max;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Latency Metrics
+
+  class LatencyMetrics
+  {
+
+    public:
+
+      // Writers 0 to writers - 1, at least one
+      explicit LatencyMetrics(std::size_t writers = 1);
+
+      // Only the given writer's thread may record into its histograms
+      void record(LatencyMessage message, LatencyStage stage,
+        std::uint64_t cycles, std::size_t writer = 0)
+      {
+        histograms_[writer][indexOf(message, stage)].record(cycles);
+      }
+
+      // Stages that recorded anything
+      std::vector<LatencySummary> summaries() const;
+
+    private:
+
+      static std::size_t indexOf(LatencyMessage message, LatencyStage stage)
+      {
+        return static_cast<std::size_t>(message) * latencyStageCount
+          + static_cast<std::size_t>(stage);
+      }
+
+      using Histograms = std::array<
+        LatencyHistogram,
+        latencyMessageCount * latencyStageCount
+      >;
+
+      std::size_t writers_;
+
+      // One set per writer
+      std::unique_ptr<Histograms[]> histograms_;
+
+  };
+
+} // Namespace FixClient
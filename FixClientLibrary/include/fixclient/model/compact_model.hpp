@@ -0,0 +1,337 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// compact_model.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Compact Models                                               │░░
+//    │                                                               │░░
+//    │  - Trivially copyable versions of the codec models            │░░
+//    │  - Enums instead of status strings                            │░░
+//    │  - Fixed capacity strings instead of std::string              │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// These can be copied with memcpy into ring buffers or shared memory.
+// Converting from a codec model never allocates, converting back
+// allocates the std::string fields.
+//
+// toCompact() truncates strings longer than their FixedString: 15
+// characters for security codes, MPIDs and accounts, 31 for execution
+// codes and timestamps, 39 for IOI and order codes and 63 for free
+// text. Codes cut short may collide, so check fitsCompact() first
+// wherever one is used as a key.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include "model/fixed_string.hpp"
+#include "model/security_model.hpp"
+#include "codec/execution_event.hpp"
+#include "codec/market_data.hpp"
+#include "codec/order_book.hpp"
+#include "codec/session_state.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Enums
+  //
+  // One per status string of the codec models, in the same order as
+  // documented there
+
+  enum class AcknowledgeStatus : std::uint8_t {
+
+    NewOrderAccepted,
+
+    OrderCanceled,
+
+    OrderReplaced
+
+  };
+
+  enum class FillStatus : std::uint8_t {
+
+    PartialFill,
+
+    CompleteFill
+
+  };
+
+  enum class PostTradeStatus : std::uint8_t {
+
+    Cancel,
+
+    Correct
+
+  };
+
+  enum class TradeSide : std::uint8_t {
+
+    Buy,
+
+    Sell
+
+  };
+
+  enum class IOIAction : std::uint8_t {
+
+    Create,
+
+    Update,
+
+    Delete
+
+  };
+
+  enum class IOISide : std::uint8_t {
+
+    Bid,
+
+    Offer
+
+  };
+
+  enum class IOIOwnership : std::uint8_t {
+
+    NotMine,
+
+    IsMine,
+
+    // On shared FIX connections only
+    MaybeMine
+
+  };
+
+  // The strings the codec models use
+  std::string_view toString(AcknowledgeStatus value);
+  std::string_view toString(FillStatus value);
+  std::string_view toString(PostTradeStatus value);
+  std::string_view toString(TradeSide value);
+  std::string_view toString(IOIAction value);
+  std::string_view toString(IOISide value);
+  std::string_view toString(IOIOwnership value);
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Compact Market Data Model
+
+  struct CompactMarketDataModel
+  {
+    // See MarketDataModel
+    double quantity;
+
+    double price;
+
+    double yield;
+
+    SecurityId securityId;
+
+    SecurityCodeString securityCode;
+
+    // FIX::MDUpdateAction
+    char action;
+
+    // FIX::MDEntryType
+    char entryType;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Compact IOI Order Model
+
+  struct CompactIOIOrderModel
+  {
+    // See IOIOrderModel
+    double quantity;
+
+    double price;
+
+    double yield;
+
+    SecurityId securityId;
+
+    IOICodeString ioiCode;
+
+    SecurityCodeString securityCode;
+
+    IOIAction action;
+
+    IOISide bidOrOffer;
+
+    IOIOwnership isMine;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Compact Session State Model
+
+  // Already trivially copyable
+  using CompactSessionStateModel = SessionStateModel;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Compact Execution Event Models
+
+  struct CompactAcknowledgeEventModel
+  {
+    AcknowledgeStatus status;
+
+    TextString reason;
+  };
+
+  struct CompactRejectEventModel
+  {
+    // FIX::OrdRejReason
+    int status;
+
+    TextString message;
+  };
+
+  struct CompactFillEventModel
+  {
+    // See FillEventModel
+    double fillQuantity;
+
+    double fillPrice;
+
+    double fillYield;
+
+    double remainingQuantity;
+
+    double principal;
+
+    double accrued;
+
+    double settlementAmount;
+
+    double cumulativeQuantity;
+
+    double averagePrice;
+
+    SecurityId securityId;
+
+    SecurityCodeString securityCode;
+
+    ExecutionCodeString executionCode;
+
+    MpidString contraClearingMpid;
+
+    MpidString contraClearingAccount;
+
+    MpidString subscriberAccount;
+
+    MpidString executedBy;
+
+    TimestampString settlementDate;
+
+    TimestampString executedAt;
+
+    FillStatus status;
+
+    TradeSide side;
+  };
+
+  struct CompactPostTradeEventModel
+  {
+    PostTradeStatus status;
+
+    ExecutionCodeString executionCode;
+
+    // If status == Correct, these are set
+    double quantity { 0.0 };
+
+    double price { 0.0 };
+
+    double yield { 0.0 };
+
+    double principal { 0.0 };
+
+    double accrued { 0.0 };
+
+    double settlement { 0.0 };
+  };
+
+  struct CompactExecutionEventModel
+  {
+    // Against which order
+    OrderCodeString orderCode;
+
+    // Payload
+    std::variant<
+      CompactAcknowledgeEventModel,
+      CompactRejectEventModel,
+      CompactFillEventModel,
+      CompactPostTradeEventModel
+    > value;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Compact Security Model
+
+  struct CompactSecurityModel
+  {
+    SecurityCodeString code;
+
+    SecurityCodeKind kind;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Conversions
+
+  CompactMarketDataModel toCompact(const MarketDataModel& model);
+  CompactIOIOrderModel toCompact(const IOIOrderModel& model);
+  CompactAcknowledgeEventModel toCompact(const AcknowledgeEventModel& model);
+  CompactRejectEventModel toCompact(const RejectEventModel& model);
+  CompactFillEventModel toCompact(const FillEventModel& model);
+  CompactPostTradeEventModel toCompact(const PostTradeEventModel& model);
+  CompactExecutionEventModel toCompact(const ExecutionEventModel& model);
+  CompactSecurityModel toCompact(const SecurityModel& model);
+
+  // False if toCompact() would truncate a code or timestamp of the
+  // model. Free text is cut at 63 characters and not checked.
+  bool fitsCompact(const MarketDataModel& model);
+  bool fitsCompact(const IOIOrderModel& model);
+  bool fitsCompact(const AcknowledgeEventModel& model);
+  bool fitsCompact(const RejectEventModel& model);
+  bool fitsCompact(const FillEventModel& model);
+  bool fitsCompact(const PostTradeEventModel& model);
+  bool fitsCompact(const ExecutionEventModel& model);
+  bool fitsCompact(const SecurityModel& model);
+
+  MarketDataModel toModel(const CompactMarketDataModel& model);
+  IOIOrderModel toModel(const CompactIOIOrderModel& model);
+  AcknowledgeEventModel toModel(const CompactAcknowledgeEventModel& model);
+  RejectEventModel toModel(const CompactRejectEventModel& model);
+  FillEventModel toModel(const CompactFillEventModel& model);
+  PostTradeEventModel toModel(const CompactPostTradeEventModel& model);
+  ExecutionEventModel toModel(const CompactExecutionEventModel& model);
+  SecurityModel toModel(const CompactSecurityModel& model);
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Guarantees
+
+  static_assert(std::is_trivially_copyable_v<CompactMarketDataModel>);
+  static_assert(std::is_trivially_copyable_v<CompactIOIOrderModel>);
+  static_assert(std::is_trivially_copyable_v<CompactSessionStateModel>);
+  static_assert(std::is_trivially_copyable_v<CompactAcknowledgeEventModel>);
+  static_assert(std::is_trivially_copyable_v<CompactRejectEventModel>);
+  static_assert(std::is_trivially_copyable_v<CompactFillEventModel>);
+  static_assert(std::is_trivially_copyable_v<CompactPostTradeEventModel>);
+  static_assert(std::is_trivially_copyable_v<CompactExecutionEventModel>);
+  static_assert(std::is_trivially_copyable_v<CompactSecurityModel>);
+
+} // Namespace FixClient
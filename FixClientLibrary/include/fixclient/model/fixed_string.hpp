@@ -0,0 +1,147 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// fixed_string.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Fixed String
+  //
+  // Inline, fixed capacity string. Trivially copyable, never allocates.
+  // Values longer than the capacity are truncated.
+
+  template <std::size_t Capacity>
+  class FixedString
+  {
+
+    static_assert(Capacity > 0 && Capacity < 256,
+      "FixedString keeps its size in one byte");
+
+    public:
+
+      constexpr FixedString() = default;
+
+      constexpr FixedString(std::string_view value)
+      {
+        assign(value);
+      }
+
+      FixedString(const std::string& value)
+      {
+        assign(value);
+      }
+
+      constexpr FixedString(const char* value)
+      {
+        assign(value);
+      }
+
+      // Returns false if the value had to be truncated
+      constexpr bool assign(std::string_view value)
+      {
+        size_ = static_cast<std::uint8_t>(
+          std::min(value.size(), Capacity)
+        );
+        std::copy_n(value.data(), size_, data_);
+
+        // Keep the unused tail zeroed so whole-struct copies and
+        // comparisons never see stale bytes
+        std::fill(data_ + size_, data_ + Capacity, '\0');
+
+        return value.size() <= Capacity;
+      }
+
+      constexpr std::string_view view() const
+      {
+        return std::string_view(data_, size_);
+      }
+
+      constexpr operator std::string_view() const
+      {
+        return view();
+      }
+
+      std::string str() const
+      {
+        return std::string(view());
+      }
+
+      constexpr std::size_t size() const
+      {
+        return size_;
+      }
+
+      constexpr bool empty() const
+      {
+        return size_ == 0;
+      }
+
+      static constexpr std::size_t capacity()
+      {
+        return Capacity;
+      }
+
+      friend constexpr bool operator==(
+        const FixedString& lhs, const FixedString& rhs)
+      {
+        return lhs.view() == rhs.view();
+      }
+
+      friend constexpr bool operator==(
+        const FixedString& lhs, std::string_view rhs)
+      {
+        return lhs.view() == rhs;
+      }
+
+    private:
+
+      char data_[Capacity] {};
+
+      std::uint8_t size_ { 0 };
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Sized Strings
+  //
+  // Capacities picked so each string, size byte included, ends on an
+  // 8 byte boundary
+
+  // ISIN (12) or CUSIP (9)
+  using SecurityCodeString = FixedString<15>;
+
+  // Market participant IDs and clearing accounts
+  using MpidString = FixedString<15>;
+
+  // ATS execution codes
+  using ExecutionCodeString = FixedString<31>;
+
+  // IOI codes, a UUID fits
+  using IOICodeString = FixedString<39>;
+
+  // Client order codes, a UUID fits
+  using OrderCodeString = FixedString<39>;
+
+  // ISO dates and UTC timestamps down to nanoseconds
+  using TimestampString = FixedString<31>;
+
+  // Free text from the venue, truncated
+  using TextString = FixedString<63>;
+
+} // Namespace FixClient
@@ -13,10 +13,21 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace FixClient {
 
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Security ID
+  //
+  // Dense index of an interned security code, see SecurityTable
+
+  using SecurityId = std::uint32_t;
+
+  // Codes that were not interned
+  constexpr SecurityId noSecurityId = 0xFFFFFFFF;
+
   // -------- -------- -------- -------- -------- -------- -------- --------
   // MARK: Security Code Kind
 
@@ -0,0 +1,230 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// event_queue.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Event Queue                                                  │░░
+//    │                                                               │░░
+//    │  - Decoded events from the QuickFIX thread to the workflow    │░░
+//    │  - Block, drop the oldest or conflate when full               │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// With queued dispatch the engine only decodes on the QuickFIX thread,
+// so a slow workflow no longer delays heartbeats and socket reads. The
+// engine's consumer thread pops the events and runs the workflow.
+//
+// The backpressure policy only ever gives up market data and IOIs.
+// Session, trading and security list events always wait for room.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "codec/execution_event.hpp"
+#include "codec/market_data.hpp"
+#include "codec/order_book.hpp"
+#include "codec/session_state.hpp"
+#include "model/security_model.hpp"
+#include "queue/market_data_conflator.hpp"
+#include "queue/session_threads.hpp"
+#include "queue/spsc_queue.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Dispatch Options
+
+  enum class EventDispatch : std::uint8_t {
+
+    // Workflow handlers run on the QuickFIX thread
+    Inline,
+
+    // Workflow handlers run on the engine's consumer thread
+    Queued,
+
+    // Each session has its own queue and consumer thread, see
+    // session_threads.hpp. Handlers of different sessions run
+    // concurrently.
+    PerSession,
+
+    // Market data and IOIs go to a pool of workers by security, see
+    // security_partitioner.hpp. Everything else to one more consumer
+    // thread. Handlers run concurrently.
+    PerSecurity
+
+  };
+
+  // What the QuickFIX thread does when the queue is full
+  enum class Backpressure : std::uint8_t {
+
+    // Wait for the workflow, which eventually stalls the socket
+    Block,
+
+    // Drop queued market data and IOIs, oldest first
+    DropOldest,
+
+    // Pass incremental refreshes through a MarketDataConflator, the
+    // workflow gets the latest entry per security and entry type
+    // whenever it is ready
+    Conflate
+
+  };
+
+  struct DispatchOptions
+  {
+    EventDispatch mode { EventDispatch::Inline };
+
+    // Events, rounded up to a power of two
+    std::size_t capacity { 4096 };
+
+    Backpressure backpressure { Backpressure::Block };
+
+    // PerSession only. Capacity and backpressure apply to each queue.
+    SessionThreadLayout sessionThreads {};
+
+    // PerSecurity only, one per core if 0
+    std::size_t securityWorkers { 0 };
+  };
+
+  struct EventQueueStats
+  {
+    // Events waiting for the workflow
+    std::size_t depth { 0 };
+
+    // Largest depth seen
+    std::size_t highWater { 0 };
+
+    // Events DropOldest gave up
+    std::uint64_t dropped { 0 };
+
+    // Market data entries Conflate collapsed into a later one
+    std::uint64_t conflated { 0 };
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Workflow Events
+
+  struct SessionEvent
+  {
+    std::string senderId;
+
+    // Logout if false
+    bool logon;
+  };
+
+  struct MarketDataEvent
+  {
+    std::vector<MarketDataModel> data;
+
+    // Full refresh if true, incremental otherwise
+    bool snapshot;
+  };
+
+  struct SecurityListEvent
+  {
+    std::vector<SecurityModel> securities;
+  };
+
+  // Tells the consumer that the conflator has entries, pop() never
+  // returns it. Stale once a snapshot flushed the entries of its
+  // generation ahead of itself.
+  struct ConflatedMarker
+  {
+    std::uint64_t generation { 0 };
+  };
+
+  using WorkflowEvent = std::variant<
+    ConflatedMarker,
+    SessionEvent,
+    MarketDataEvent,
+    IOIOrderModel,
+    ExecutionEventModel,
+    SessionStateModel,
+    SecurityListEvent
+  >;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Event Queue
+
+  class EventQueue
+  {
+
+    public:
+
+      EventQueue(std::size_t capacity, Backpressure backpressure);
+
+      // QuickFIX thread. Applies the backpressure policy when full.
+      void push(WorkflowEvent&& event);
+
+      // Consumer thread. Waits for the next event, returns false once
+      // stopped and drained.
+      bool pop(WorkflowEvent& event);
+
+      // Lets pop() return false after the last event
+      void stop();
+
+      // Nothing queued or conflated
+      bool empty() const
+      {
+        return queue_.empty() && conflator_.empty();
+      }
+
+      EventQueueStats stats() const;
+
+    private:
+
+      // Waits for room, dropping the oldest if the policy allows
+      void pushEvent(WorkflowEvent& event, bool discardable);
+
+      void pushMarketData(WorkflowEvent& event);
+
+      // Only entries of the given generation, if there is one
+      bool takeConflated(WorkflowEvent& event,
+        const std::uint64_t* generation);
+
+      bool hasWork() const;
+
+      void recordDepth();
+
+      void wake();
+
+      SpscQueue<WorkflowEvent> queue_;
+
+      Backpressure backpressure_;
+
+      // Written by the QuickFIX thread only
+      std::atomic<std::size_t> highWater_ { 0 };
+      std::atomic<std::uint64_t> dropped_ { 0 };
+
+      // Conflate only. At most one current marker waits in the queue,
+      // if it found no room the consumer looks once the queue ran dry.
+      MarketDataConflator conflator_;
+      std::atomic<bool> conflatedQueued_ { false };
+
+      // Parks the consumer while there is nothing to do
+      std::atomic<bool> waiting_ { false };
+      std::atomic<bool> stopped_ { false };
+      std::atomic<std::uint32_t> signal_ { 0 };
+
+  };
+
+} // Namespace FixClient
@@ -0,0 +1,117 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// market_data_conflator.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Market Data Conflator                                        │░░
+//    │                                                               │░░
+//    │  - Latest entry per security and entry type                   │░░
+//    │  - Delivered whenever the consumer is ready                   │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Sits between the Market Data Codec and a consumer that may fall
+// behind. The feed thread adds incremental refreshes, each entry lands
+// in the slot of its security and entry type and marks it dirty. The
+// consumer takes the dirty slots, in the order they first got dirty,
+// and only ever sees the latest value of each.
+//
+// Slots are a flat array indexed by SecurityId, so models need one.
+// Entries without a SecurityId or with an entry type the top of book
+// does not know pass through unconflated.
+//
+// add() and take() may run on different threads.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "codec/market_data.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Market Data Conflator
+
+  class MarketDataConflator
+  {
+
+    public:
+
+      // Returns true if the conflator was clean before
+      bool add(const std::vector<MarketDataModel>& data);
+
+      // Replaces out with the dirty entries and cleans the slots.
+      // False if there was nothing to take.
+      bool take(std::vector<MarketDataModel>& out);
+
+      // As take(), only while no flush() happened since generation()
+      // was read
+      bool take(std::vector<MarketDataModel>& out,
+        std::uint64_t generation);
+
+      // As take(), and starts a new generation. For a snapshot that
+      // puts the entries ahead of itself.
+      bool flush(std::vector<MarketDataModel>& out);
+
+      std::uint64_t generation() const
+      {
+        return generation_.load(std::memory_order_acquire);
+      }
+
+      bool empty() const
+      {
+        return !dirty_.load(std::memory_order_acquire);
+      }
+
+      // Entries replaced by a later one before the consumer took them
+      std::uint64_t collapsed() const
+      {
+        return collapsed_.load(std::memory_order_relaxed);
+      }
+
+      void clear();
+
+    private:
+
+      static constexpr std::uint32_t unkeyed = 0xFFFFFFFF;
+
+      bool takeLocked(std::vector<MarketDataModel>& out);
+
+      std::mutex mutex_;
+
+      // Latest entry per SecurityId and TopOfBookEntry
+      std::vector<MarketDataModel> slots_;
+      std::vector<std::uint8_t> isDirty_;
+
+      // Dirty slots, first dirtied first, and the entries without a
+      // slot, marked unkeyed at their place
+      std::vector<std::uint32_t> order_;
+      std::vector<MarketDataModel> unkeyed_;
+
+      std::atomic<bool> dirty_ { false };
+
+      // Bumped by flush(), under the lock
+      std::atomic<std::uint64_t> generation_ { 0 };
+      std::atomic<std::uint64_t> collapsed_ { 0 };
+
+  };
+
+} // Namespace FixClient
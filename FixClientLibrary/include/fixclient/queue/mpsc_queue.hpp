@@ -0,0 +1,181 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// mpsc_queue.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  MPSC Queue                                                   │░░
+//    │                                                               │░░
+//    │  - Bounded, lock free, any number of producers, one consumer  │░░
+//    │  - Each entry gets its position, entries leave in that order  │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Slots carry sequence numbers as in SpscQueue. Producers claim a
+// position with a compare and swap on the tail, then write their slot
+// and publish it. The consumer takes positions in order, so it waits
+// for a producer that claimed a position but has not published it yet,
+// even when later positions are ready.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: MPSC Queue
+
+  template <typename T>
+  class MpscQueue
+  {
+
+    public:
+
+      // Rounded up to a power of two
+      explicit MpscQueue(std::size_t capacity);
+
+      MpscQueue(const MpscQueue&) = delete;
+      MpscQueue& operator=(const MpscQueue&) = delete;
+
+      // Any thread. Moves from value and returns true if there was
+      // room, with the position the entry got. Positions start at 0 and
+      // grow by one per entry.
+      bool tryPush(T& value, std::size_t& position);
+
+      // Consumer. Moves the oldest entry into value, with its position.
+      bool tryPop(T& value, std::size_t& position);
+
+      // Approximate when called from a producer
+      std::size_t size() const
+      {
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+      }
+
+      bool empty() const
+      {
+        return size() == 0;
+      }
+
+      std::size_t capacity() const
+      {
+        return mask_ + 1;
+      }
+
+    private:
+
+      struct Slot
+      {
+        std::atomic<std::size_t> sequence;
+
+        T value;
+      };
+
+      static constexpr std::size_t cacheLine = 64;
+
+      std::size_t mask_;
+
+      std::unique_ptr<Slot[]> slots_;
+
+      // Next position to take, moved by the consumer
+      alignas(cacheLine) std::atomic<std::size_t> head_ { 0 };
+
+      // Next position to claim, moved by the producers
+      alignas(cacheLine) std::atomic<std::size_t> tail_ { 0 };
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Implementation
+
+  template <typename T>
+  MpscQueue<T>::MpscQueue(std::size_t capacity) :
+    mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+    slots_(std::make_unique<Slot[]>(mask_ + 1))
+  {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename T>
+  bool MpscQueue<T>::tryPush(T& value, std::size_t& position)
+  {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+    for (;;) {
+      Slot& slot = slots_[tail & mask_];
+      const std::size_t sequence =
+        slot.sequence.load(std::memory_order_acquire);
+
+      // Free for this lap, claim it
+      if (sequence == tail) {
+        if (tail_.compare_exchange_weak(tail, tail + 1,
+          std::memory_order_relaxed, std::memory_order_relaxed)
+        ) {
+          break;
+        }
+        continue;
+      }
+
+      // Still holding the entry of the previous lap
+      if (sequence < tail) {
+        return false;
+      }
+
+      // Another producer claimed it first
+      tail = tail_.load(std::memory_order_relaxed);
+    }
+
+    Slot& slot = slots_[tail & mask_];
+    slot.value = std::move(value);
+    slot.sequence.store(tail + 1, std::memory_order_release);
+
+    position = tail;
+    return true;
+  }
+
+  template <typename T>
+  bool MpscQueue<T>::tryPop(T& value, std::size_t& position)
+  {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[head & mask_];
+
+    // Empty, or claimed but not published yet
+    if (slot.sequence.load(std::memory_order_acquire) != head + 1) {
+      return false;
+    }
+
+    value = std::move(slot.value);
+    slot.value = T {};
+
+    // Free for the producers' next lap
+    slot.sequence.store(head + mask_ + 1, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_release);
+
+    position = head;
+    return true;
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,77 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// security_partitioner.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Security Partitioner                                         │░░
+//    │                                                               │░░
+//    │  - Maps every security to a fixed worker                      │░░
+//    │  - Splits market data by worker, keeping the entry order      │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// With EventDispatch::PerSecurity the engine spreads market data and
+// IOIs over a pool of workers. A security always lands on the same
+// worker, so its updates stay in order while different securities are
+// handled in parallel.
+//
+// SecurityIds are dense and handed out in the order codes are first
+// seen, so the ID modulo the worker count spreads them evenly. Models
+// without an ID fall back to a hash of the code.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "codec/market_data.hpp"
+#include "model/security_model.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Security Partitioner
+
+  class SecurityPartitioner
+  {
+
+    public:
+
+      // One worker per core if 0
+      explicit SecurityPartitioner(std::size_t workers);
+
+      std::size_t workers() const
+      {
+        return workers_;
+      }
+
+      std::size_t workerOf(SecurityId securityId,
+        std::string_view securityCode) const;
+
+      // Resizes parts to one vector per worker and appends each entry
+      // to its worker's
+      void split(const std::vector<MarketDataModel>& data,
+        std::vector<std::vector<MarketDataModel>>& parts) const;
+
+    private:
+
+      std::size_t workers_;
+
+  };
+
+} // Namespace FixClient
@@ -0,0 +1,100 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// session_threads.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Session Threads                                              │░░
+//    │                                                               │░░
+//    │  - One consumer thread per -MD, -OB and -TR session           │░░
+//    │  - Optionally pinned to a core, optionally real time          │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// With EventDispatch::PerSession the engine keeps an event queue and a
+// consumer thread per session, so a market data burst no longer sits
+// in front of an execution report. The layout says where each thread
+// runs.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Session Role
+
+  enum class SessionRole : std::uint8_t {
+
+    MarketData,
+
+    OrderBook,
+
+    Trading
+
+  };
+
+  constexpr std::size_t sessionRoleCount = 3;
+
+  // From the "-MD" or "-OB" suffix of a comp ID, anything else trades
+  SessionRole sessionRoleOf(std::string_view compId);
+
+  const char* toString(SessionRole role);
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Session Thread Layout
+
+  struct SessionThreadOptions
+  {
+    // Core the thread is pinned to, none if negative. Linux only.
+    int cpu { -1 };
+
+    // SCHED_FIFO priority from 1 to 99, the default policy if 0. Needs
+    // root or CAP_SYS_NICE.
+    int realtimePriority { 0 };
+  };
+
+  struct SessionThreadLayout
+  {
+    SessionThreadOptions marketData;
+    SessionThreadOptions orderBook;
+    SessionThreadOptions trading;
+
+    const SessionThreadOptions& operator[](SessionRole role) const
+    {
+      switch (role) {
+        case SessionRole::MarketData:
+          return marketData;
+
+        case SessionRole::OrderBook:
+          return orderBook;
+
+        case SessionRole::Trading:
+          break;
+      }
+      return trading;
+    }
+  };
+
+  // Applies the options to the calling thread. Logs what the system
+  // refused and carries on.
+  void configureSessionThread(SessionRole role,
+    const SessionThreadOptions& options);
+
+} // Namespace FixClient
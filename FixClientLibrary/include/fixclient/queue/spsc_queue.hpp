@@ -0,0 +1,219 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// spsc_queue.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  SPSC Queue                                                   │░░
+//    │                                                               │░░
+//    │  - Bounded, lock free, one producer and one consumer          │░░
+//    │  - The producer may discard the oldest entry when full        │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Every slot carries a sequence number telling whose turn it is, so
+// the consumer never sees a half written entry and the producer never
+// overwrites one that is still being moved out. Taking the oldest
+// entry is a compare and swap on the head, which lets the producer
+// race the consumer for it in discardOldest().
+//
+// Values are moved in and out, so a slot keeps no resources once the
+// consumer took its entry.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: SPSC Queue
+
+  template <typename T>
+  class SpscQueue
+  {
+
+    public:
+
+      // Rounded up to a power of two
+      explicit SpscQueue(std::size_t capacity);
+
+      SpscQueue(const SpscQueue&) = delete;
+      SpscQueue& operator=(const SpscQueue&) = delete;
+
+      // Producer. Moves from value and returns true if there was room.
+      // Only discardable entries can be taken by discardOldest().
+      bool tryPush(T& value, bool discardable = false);
+
+      // Producer. True if the next tryPush() succeeds.
+      bool hasRoom() const
+      {
+        const std::size_t position = tail_.load(std::memory_order_relaxed);
+        return slots_[position & mask_].sequence.load(
+          std::memory_order_acquire) == position;
+      }
+
+      // Producer. Drops the oldest entry if it was pushed discardable
+      // and the consumer did not take it first.
+      bool discardOldest();
+
+      // Consumer. Moves the oldest entry into value.
+      bool tryPop(T& value);
+
+      // Approximate when called from a third thread
+      std::size_t size() const
+      {
+        // Head first, it never passes a later tail
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+      }
+
+      bool empty() const
+      {
+        return size() == 0;
+      }
+
+      std::size_t capacity() const
+      {
+        return mask_ + 1;
+      }
+
+    private:
+
+      // Claims the entry at position for whoever calls. False if it is
+      // not written yet or the other side got it first.
+      bool take(std::size_t position, T* value);
+
+      struct Slot
+      {
+        std::atomic<std::size_t> sequence;
+
+        T value;
+      };
+
+      static constexpr std::size_t cacheLine = 64;
+
+      std::size_t mask_;
+
+      std::unique_ptr<Slot[]> slots_;
+
+      // Producer only, one flag per slot
+      std::vector<std::uint8_t> discardable_;
+
+      // Next position to take, moved by both sides
+      alignas(cacheLine) std::atomic<std::size_t> head_ { 0 };
+
+      // Next position to fill, moved by the producer
+      alignas(cacheLine) std::atomic<std::size_t> tail_ { 0 };
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Implementation
+
+  template <typename T>
+  SpscQueue<T>::SpscQueue(std::size_t capacity) :
+    mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1),
+    slots_(std::make_unique<Slot[]>(mask_ + 1)),
+    discardable_(mask_ + 1, 0)
+  {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename T>
+  bool SpscQueue<T>::tryPush(T& value, bool discardable)
+  {
+    const std::size_t position = tail_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[position & mask_];
+
+    // Still holding the entry of the previous lap
+    if (slot.sequence.load(std::memory_order_acquire) != position) {
+      return false;
+    }
+
+    slot.value = std::move(value);
+    discardable_[position & mask_] = discardable;
+
+    slot.sequence.store(position + 1, std::memory_order_release);
+    tail_.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  template <typename T>
+  bool SpscQueue<T>::discardOldest()
+  {
+    const std::size_t position = head_.load(std::memory_order_relaxed);
+    if (!discardable_[position & mask_]) {
+      return false;
+    }
+    return take(position, nullptr);
+  }
+
+  template <typename T>
+  bool SpscQueue<T>::tryPop(T& value)
+  {
+    std::size_t position = head_.load(std::memory_order_relaxed);
+
+    // Only fails for good when empty, the producer may have discarded
+    // the entry under us
+    while (!take(position, &value)) {
+      const std::size_t head = head_.load(std::memory_order_relaxed);
+      if (head == position) {
+        return false;
+      }
+      position = head;
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool SpscQueue<T>::take(std::size_t position, T* value)
+  {
+    Slot& slot = slots_[position & mask_];
+
+    // Not written yet, or already taken
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+      return false;
+    }
+
+    if (!head_.compare_exchange_strong(position, position + 1,
+      std::memory_order_acq_rel, std::memory_order_relaxed)
+    ) {
+      return false;
+    }
+
+    if (value != nullptr) {
+      *value = std::move(slot.value);
+    } else {
+      slot.value = T {};
+    }
+
+    // Free for the producer's next lap
+    slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+} // Namespace FixClient
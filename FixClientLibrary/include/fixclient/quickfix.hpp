@@ -32,6 +32,8 @@
 #include <quickfix/Group.h>
 #include <quickfix/FileLog.h>
 #include <quickfix/FileStore.h>
+#include <quickfix/MemoryStore.h>
+#include <quickfix/Session.h>
 #include <quickfix/SocketInitiator.h>
 #include <quickfix/fix44/MessageCracker.h>
 
@@ -0,0 +1,210 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// ioi_book.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  IOI Book                                                     │░░
+//    │                                                               │░░
+//    │  - Depth of book per security from the IOI feed               │░░
+//    │  - Orders found by IOI code in constant time                  │░░
+//    │  - Price levels aggregated per side, best first               │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Orders live in a pool that recycles its slots through a free list,
+// indexed by an open addressing table on the IOI code. Securities are
+// a flat array indexed by SecurityId, each keeps its bid and offer
+// levels in sorted arrays, which stay short for bonds. Arrays keep
+// their room as orders and levels go, clear() included, so applying
+// an IOI only allocates when the book grows past what it held before:
+// more resting orders, a SecurityId past the last one, or more levels
+// on one side of a book. reserve() makes that room up front.
+//
+// A Create for a known IOI code is applied as an Update and the other
+// way around. Deletes for unknown codes are ignored.
+//
+// Not thread safe. The engine updates it on the thread running the
+// workflow, the consumer thread under queued dispatch.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "log.hpp"
+#include "codec/order_book.hpp"
+#include "model/compact_model.hpp"
+#include "state/security_table.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: IOI Book Models
+
+  struct IOIBookLevel
+  {
+    double price;
+
+    // Of the order that opened the level. Orders at one price of one
+    // bond quote the same yield up to rounding, so it is not averaged.
+    double yield;
+
+    // Sum over the orders
+    double quantity;
+
+    std::uint32_t orders;
+
+    // How many of the orders are IsMine and MaybeMine
+    std::uint32_t mine;
+
+    std::uint32_t maybeMine;
+
+    bool hasMine() const
+    {
+      return mine > 0;
+    }
+
+    bool hasMaybeMine() const
+    {
+      return maybeMine > 0;
+    }
+  };
+
+  struct IOISecurityBook
+  {
+    // Highest price first
+    std::vector<IOIBookLevel> bids;
+
+    // Lowest price first
+    std::vector<IOIBookLevel> offers;
+
+    const std::vector<IOIBookLevel>& levels(IOISide side) const
+    {
+      return side == IOISide::Bid ? bids : offers;
+    }
+  };
+
+  struct IOIBookOrder
+  {
+    IOICodeString ioiCode;
+
+    double quantity;
+
+    double price;
+
+    double yield;
+
+    SecurityId security;
+
+    // Of the IOI code, kept for the index
+    std::uint32_t hash;
+
+    // Pool free list, only meaningful for free slots
+    std::uint32_t nextFree;
+
+    IOISide side;
+
+    IOIOwnership ownership;
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: IOI Book
+
+  class IOIBook
+  {
+
+    public:
+
+      // Books are indexed by the SecurityIds of this table. Models
+      // without one are interned here.
+      explicit IOIBook(SecurityTable& securities);
+
+      // Returns false if the IOI did not change the book: a delete of
+      // an unknown code, or a create or update matching the resting
+      // order. IOIs whose codes do not fit the compact model are logged
+      // and ignored, as a truncated IOI code could merge two orders.
+      bool apply(const IOIOrderModel& model);
+
+      bool apply(const CompactIOIOrderModel& model);
+
+      // Nullptr until the security got an IOI. Valid until the next
+      // apply().
+      const IOISecurityBook* find(SecurityId securityId) const;
+
+      const IOISecurityBook* find(std::string_view securityCode) const;
+
+      const IOIBookOrder* findOrder(std::string_view ioiCode) const;
+
+      std::size_t orderCount() const
+      {
+        return orderCount_;
+      }
+
+      // Room for this many resting orders, for books of SecurityIds
+      // below securities, and for that many price levels on each side
+      // of each of those books
+      void reserve(std::size_t orders, std::size_t securities = 0,
+        std::size_t levels = 0);
+
+      // Keeps the room of the orders, books and levels
+      void clear();
+
+    private:
+
+      static constexpr std::uint32_t none = 0xFFFFFFFF;
+
+      static std::uint32_t hashOf(std::string_view ioiCode);
+
+      SecurityId securityFor(const CompactIOIOrderModel& model);
+
+      // Order pool
+      std::uint32_t allocateOrder();
+      void freeOrder(std::uint32_t order);
+
+      // IOI code index, linear probing
+      std::size_t findSlot(std::string_view ioiCode,
+        std::uint32_t hash) const;
+      void insertIndex(std::uint32_t order);
+      void eraseIndex(std::size_t slot);
+      void growIndex();
+
+      // Price levels
+      void addToLevel(const IOIBookOrder& order);
+      void removeFromLevel(const IOIBookOrder& order);
+
+      std::vector<IOIBookOrder> orders_;
+      std::uint32_t freeList_ { none };
+      std::size_t orderCount_ { 0 };
+
+      // Order per slot, `none` when empty. Size is a power of two.
+      std::vector<std::uint32_t> index_;
+
+      SecurityTable& securities_;
+
+      // Indexed by SecurityId, grown as IDs show up
+      std::vector<IOISecurityBook> books_;
+      std::vector<std::uint8_t> active_;
+
+      // Caps the warning for oversize codes
+      LogRateLimiter oversizeLimiter_ { 1 };
+
+      Log log_;
+
+  };
+
+} // Namespace FixClient
@@ -0,0 +1,328 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_cache.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Order Cache                                                  │░░
+//    │                                                               │░░
+//    │  - The state of every order sent, by ClOrdID                  │░░
+//    │  - Cumulative quantity, leaves and average price              │░░
+//    │  - Lock free lookups from any thread                          │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// An order and its replaces and cancel share one record, found under
+// any of their ClOrdIDs. Sending moves the record to a pending state,
+// the execution reports move it on:
+//
+//   PendingNew     --ack-->       Live      --fill-->     Filled
+//   Live           --replace-->   PendingReplace --ack--> Live
+//   Live           --cancel-->    PendingCancel  --ack--> Canceled
+//
+// A rejected replace or cancel goes back to Live, a rejected new order
+// ends Rejected. A new order that was never sent, blocked by the risk
+// gate or failing to send, ends Rejected too, until it is sent again
+// under the same ClOrdID. Quantities are counted from the fills, not taken from
+// the venue, and post trade cancels and corrections adjust them.
+//
+// ClOrdIDs hash into an open addressing table with linear probing.
+// Records are never removed, so the capacity bounds the orders of a
+// session; orders past it are not tracked. Nor are ClOrdIDs longer than
+// an OrderCodeString holds, and fills whose ExecID is longer than an
+// ExecutionCodeString cannot be busted. The risk gate blocks orders the
+// cache cannot track, their exposure would go unseen.
+//
+// The writers return how each change moved the order's exposure, the
+// notional still working on the venue, for the risk gate to track.
+//
+// Writers take a lock, sendOrder() and the engine may run on different
+// threads. find() never waits, each record is SeqLocked.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "log.hpp"
+#include "codec/execution_event.hpp"
+#include "dispatch/order.hpp"
+#include "model/fixed_string.hpp"
+#include "state/seq_locked.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Order State
+
+  enum class OrderState : std::uint8_t {
+
+    // Sent, not acknowledged yet
+    PendingNew,
+
+    // Working on the venue, possibly partially filled
+    Live,
+
+    // A replace was sent, the order works as before until its ack
+    PendingReplace,
+
+    // A cancel was sent
+    PendingCancel,
+
+    // Nothing left to fill. Final.
+    Filled,
+
+    // Final
+    Canceled,
+
+    // The new order was rejected. Final.
+    Rejected
+
+  };
+
+  std::string_view toString(OrderState value);
+
+  // No execution report moves the order on
+  constexpr bool isFinal(OrderState state)
+  {
+    return state == OrderState::Filled
+      || state == OrderState::Canceled
+      || state == OrderState::Rejected;
+  }
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Order Record
+
+  struct OrderRecord
+  {
+    // The ClOrdID the venue knows the order by, the latest replace
+    // once acknowledged
+    OrderCodeString orderCode;
+
+    // The replace or cancel waiting for its ack, empty otherwise
+    OrderCodeString pendingOrderCode;
+
+    SecurityCodeString securityCode;
+
+    OrderState state { OrderState::PendingNew };
+
+    OrderSide side { OrderSide::Buy };
+
+    OrderKind kind { OrderKind::Limit };
+
+    // Rejected before it reached the venue, see onSendFailed(). Sending
+    // the same ClOrdID again reopens it.
+    bool notSent { false };
+
+    // FIX::OrdRejReason of the last reject, 0 if none
+    std::int32_t rejectReason { 0 };
+
+    // Fills applied, post trade cancels do not count down
+    std::uint32_t fills { 0 };
+
+    // As acknowledged
+    double quantity { 0.0 };
+
+    double price { 0.0 };
+
+    // What the pending replace asks for
+    double pendingQuantity { 0.0 };
+
+    double pendingPrice { 0.0 };
+
+    // Sum of the fills
+    double cumulativeQuantity { 0.0 };
+
+    // Still working, 0 once final
+    double leavesQuantity { 0.0 };
+
+    // Quantity weighted fill price
+    double averagePrice { 0.0 };
+  };
+
+  // The notional the order can still fill, the larger of the working
+  // order and its pending replace. 0 once final.
+  double exposureOf(const OrderRecord& record);
+
+  // What a writer did to the exposure of an order's security
+  struct ExposureChange
+  {
+    SecurityCodeString securityCode;
+
+    double change { 0.0 };
+
+    // False when the cache could not take the order: full, the code
+    // too long, or a replace of an order it does not know
+    bool tracked { true };
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Order Cache
+
+  class OrderCache
+  {
+
+    public:
+
+      // Orders, the key and fill tables get room for a few times more
+      explicit OrderCache(std::size_t capacity = 4096);
+
+      // -------- -------- -------- --------
+      // MARK: Writers
+
+      // Call before sending, so the execution report never arrives
+      // first. Orders not tracked change nothing and come back
+      // untracked. A new order already known changes nothing either,
+      // unless it was never sent.
+      ExposureChange onOrderSent(const OrderModel& model);
+
+      // Call if the order was not sent after all. Undoes onOrderSent
+      // as a reject would.
+      ExposureChange onSendFailed(const OrderModel& model);
+
+      // Execution reports of orders never sent through this cache are
+      // ignored, and so are fills whose ExecID was already applied
+      ExposureChange apply(const ExecutionEventModel& event);
+
+      // -------- -------- -------- --------
+      // MARK: Readers
+
+      // Any thread. False if the code is unknown.
+      bool find(std::string_view orderCode, OrderRecord& record) const;
+
+      // Orders tracked
+      std::size_t size() const
+      {
+        return size_.load(std::memory_order_acquire);
+      }
+
+      std::size_t capacity() const
+      {
+        return capacity_;
+      }
+
+    private:
+
+      static constexpr std::uint32_t noRecord = 0;
+
+      // A ClOrdID and the record it belongs to. Published once, by the
+      // release store of record, and never changed after.
+      struct KeySlot
+      {
+        std::atomic<std::uint32_t> record { noRecord };
+
+        OrderCodeString orderCode;
+      };
+
+      // Writer side only, for post trade events
+      struct FillSlot
+      {
+        ExecutionCodeString executionCode;
+
+        // noRecord if unused
+        std::uint32_t record { noRecord };
+
+        double quantity { 0.0 };
+
+        double price { 0.0 };
+      };
+
+      static std::size_t hashOf(std::string_view code);
+
+      // 1 based record number, noRecord if unknown
+      std::uint32_t recordOf(std::string_view orderCode) const;
+
+      // False when the table is full or the code does not fit
+      bool addKey(std::string_view orderCode, std::uint32_t record);
+
+      // A new record, noRecord if there is no room
+      std::uint32_t addRecord(std::string_view orderCode,
+        const OrderRecord& record);
+
+      FillSlot* findFill(std::string_view executionCode);
+
+      // Null when the table is full or the code does not fit
+      FillSlot* addFill(std::string_view executionCode);
+
+      // Under the lock. The writers' copy, which readers never touch.
+      OrderRecord& recordAt(std::uint32_t record)
+      {
+        return shadow_[record - 1];
+      }
+
+      void publish(std::uint32_t record)
+      {
+        records_[record - 1].store(shadow_[record - 1]);
+      }
+
+      // The rejected code was a replace or cancel of the record, or
+      // the new order itself
+      void reject(std::uint32_t record, std::string_view orderCode,
+        int reason);
+
+      void acknowledge(std::uint32_t record, std::string_view orderCode,
+        const AcknowledgeEventModel& model);
+
+      void fill(std::uint32_t record, const FillEventModel& model);
+
+      ExposureChange postTrade(const PostTradeEventModel& model);
+
+      // From before, the record's exposure ahead of the change
+      ExposureChange changeOf(std::uint32_t record, double before);
+
+      // Recomputes leaves and the average price after the fills or the
+      // quantity changed
+      void settle(std::uint32_t record);
+
+      // Serializes the writers
+      std::mutex mutex_;
+
+      // What readers see
+      std::unique_ptr<SeqLocked<OrderRecord>[]> records_;
+      std::size_t capacity_;
+
+      // The writers' copy of each record, and the fill notional
+      // behind its average price
+      std::vector<OrderRecord> shadow_;
+      std::vector<double> notional_;
+
+      // Power of two sizes
+      std::unique_ptr<KeySlot[]> keys_;
+      std::size_t keyMask_;
+
+      std::vector<FillSlot> fills_;
+      std::size_t fillMask_;
+
+      std::atomic<std::size_t> size_ { 0 };
+
+      std::size_t keyCount_ { 0 };
+      std::size_t fillCount_ { 0 };
+
+      // Caps the warnings once a table is full
+      LogRateLimiter fullLimiter_ { 1 };
+
+      // Caps the warnings about codes too long to keep
+      LogRateLimiter oversizeLimiter_ { 1 };
+
+      Log log_;
+
+  };
+
+} // Namespace FixClient
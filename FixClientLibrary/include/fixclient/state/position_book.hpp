@@ -0,0 +1,216 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// position_book.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Position Book                                                │░░
+//    │                                                               │░░
+//    │  - Position per security and subscriber account               │░░
+//    │  - Average cost, realized P&L and cash, updated per fill      │░░
+//    │  - Post trade cancels and corrections by execution code       │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Each fill moves one position in O(1). A fill in the position's
+// direction adds to its cost at the fill price, one against it realizes
+// the difference between the fill's principal and the cost it closes.
+//
+// Fills are remembered by execution code, so a post trade cancel books
+// the opposite trade at the same price and cash, and a correction
+// cancels the fill and books the corrected one. Quantities and cash then
+// match a recompute exactly. Average cost and realized P&L may split
+// differently when the busted fill had closed part of the position,
+// their sum at any mark does not change.
+//
+// The table keeps the latest fillCapacity fills and forgets the oldest
+// as new ones arrive, so a long session never fills it up. Fills resent
+// after a reconnect are recent ones and are still skipped. A fill older
+// than the table would be booked again, and a bust of one is ignored.
+//
+// One writer, the engine on the thread decoding execution reports.
+// find() and snapshot() read from any thread without locking it out,
+// each position is SeqLocked and consistent on its own.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "log.hpp"
+#include "codec/execution_event.hpp"
+#include "model/fixed_string.hpp"
+#include "state/seq_locked.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Position Model
+
+  struct PositionModel
+  {
+    SecurityCodeString securityCode;
+
+    SecurityId securityId { noSecurityId };
+
+    // FillEventModel::subscriberAccount, empty if none was sent.
+    // Truncated to 15 characters, as the key.
+    MpidString subscriberAccount;
+
+    // Fills applied, busts and corrections do not count
+    std::uint32_t fills { 0 };
+
+    // Bought minus sold
+    double quantity { 0.0 };
+
+    // Fill price of the open quantity, quantity weighted
+    double averageCost { 0.0 };
+
+    // Principal paid for a long, or received for a short, position
+    double costBasis { 0.0 };
+
+    // Principal of the closing fills less the cost basis they closed
+    double realized { 0.0 };
+
+    // Cash, received for sells minus paid for buys
+    double principal { 0.0 };
+
+    double accrued { 0.0 };
+
+    double settlementAmount { 0.0 };
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Position Book
+
+  class PositionBook
+  {
+
+    public:
+
+      // Positions, and the latest fills, remembered for resends and post
+      // trade events. The tables get a third more room.
+      explicit PositionBook(std::size_t positionCapacity = 4096,
+        std::size_t fillCapacity = 16384);
+
+      // Fills and post trade events, anything else is ignored
+      void apply(const ExecutionEventModel& event);
+
+      // Any thread. False if nothing traded under the key yet.
+      bool find(std::string_view securityCode,
+        std::string_view subscriberAccount, PositionModel& position) const;
+
+      // Any thread. Replaces out with every position.
+      void snapshot(std::vector<PositionModel>& out) const;
+
+      std::size_t size() const
+      {
+        return size_.load(std::memory_order_acquire);
+      }
+
+    private:
+
+      static constexpr std::uint32_t noPosition = 0;
+
+      // Published once, by the release store of position
+      struct PositionSlot
+      {
+        std::atomic<std::uint32_t> position { noPosition };
+
+        SecurityCodeString securityCode;
+
+        MpidString subscriberAccount;
+      };
+
+      // Writer only
+      struct FillSlot
+      {
+        ExecutionCodeString executionCode;
+
+        // noPosition if unused
+        std::uint32_t position { noPosition };
+
+        bool isSell { false };
+
+        // Zero once busted
+        double quantity { 0.0 };
+
+        double price { 0.0 };
+
+        double principal { 0.0 };
+
+        double accrued { 0.0 };
+
+        double settlementAmount { 0.0 };
+      };
+
+      void fill(const FillEventModel& model);
+
+      void postTrade(const PostTradeEventModel& model);
+
+      // Books the fill, or the opposite trade to bust it
+      void trade(std::uint32_t position, const FillSlot& fill,
+        bool reverse);
+
+      static std::size_t hashOf(std::string_view securityCode,
+        std::string_view subscriberAccount);
+
+      // 1 based, noPosition if unknown
+      std::uint32_t positionOf(std::string_view securityCode,
+        std::string_view subscriberAccount) const;
+
+      // noPosition once full
+      std::uint32_t addPosition(const FillEventModel& model);
+
+      FillSlot* findFill(std::string_view executionCode);
+
+      // Forgets the oldest fill once the table is full
+      FillSlot* addFill(std::string_view executionCode);
+
+      void eraseFill(std::size_t slot);
+
+      // The writer's copy of each position, and what readers see
+      std::size_t capacity_;
+      std::vector<PositionModel> shadow_;
+      std::unique_ptr<SeqLocked<PositionModel>[]> positions_;
+
+      // Power of two sizes
+      std::unique_ptr<PositionSlot[]> keys_;
+      std::size_t keyMask_;
+
+      std::vector<FillSlot> fills_;
+      std::size_t fillMask_;
+      std::size_t fillCapacity_;
+      std::size_t fillCount_ { 0 };
+
+      // Execution codes of the remembered fills, oldest at fillNext_
+      // once full
+      std::vector<ExecutionCodeString> fillOrder_;
+      std::size_t fillNext_ { 0 };
+
+      std::atomic<std::size_t> size_ { 0 };
+
+      // Caps the warnings once a table is full
+      LogRateLimiter fullLimiter_ { 1 };
+
+      Log log_;
+
+  };
+
+} // Namespace FixClient
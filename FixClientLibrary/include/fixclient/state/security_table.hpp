@@ -0,0 +1,121 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// security_table.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Security Table                                               │░░
+//    │                                                               │░░
+//    │  - Interns ISIN and CUSIP codes into dense SecurityIds        │░░
+//    │  - Perfect hash over the Security List                        │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// IDs count up from zero in the order codes are first seen and never
+// change, so they index flat arrays. seed() builds a collision free
+// hash (hash and displace) over the Security List, a lookup then costs
+// one hash and one compare. Codes outside the list still get an ID,
+// through a regular hash map, until the next seed().
+//
+// Not thread safe. The engine uses it from the QuickFIX callbacks,
+// which SocketInitiator runs on one thread. Under queued or per session
+// dispatch the workflow must not look codes up from its handlers.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "model/security_model.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Security Table
+
+  class SecurityTable
+  {
+
+    public:
+
+      // Interns every listed code and rebuilds the perfect hash. Codes
+      // interned before keep their IDs.
+      void seed(const std::vector<SecurityModel>& securities);
+
+      // The code's ID, interned first if new
+      SecurityId intern(std::string_view code);
+
+      // noSecurityId if the code was never interned
+      SecurityId find(std::string_view code) const;
+
+      // Stays valid as the table grows
+      const std::string& code(SecurityId id) const
+      {
+        return codes_[id];
+      }
+
+      std::size_t size() const
+      {
+        return codes_.size();
+      }
+
+    private:
+
+      struct CodeHash
+      {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view code) const
+        {
+          return std::hash<std::string_view>{}(code);
+        }
+      };
+
+      static std::uint64_t hashOf(std::string_view code);
+
+      std::size_t slotOf(std::uint64_t hash) const;
+
+      // False if no displacement fits, the caller retries larger
+      bool buildPerfectHash(std::size_t slotCount);
+
+      // Perfect hash: bucket -> displacement, slot -> ID
+      std::vector<std::uint32_t> displacements_;
+      std::vector<SecurityId> slots_;
+
+      // Codes interned since the last seed()
+      std::unordered_map<std::string, SecurityId, CodeHash,
+        std::equal_to<>> overflow_;
+
+      std::deque<std::string> codes_;
+
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Codec Helper
+
+  // Codecs built without a table leave models at noSecurityId
+  inline SecurityId internSecurity(SecurityTable* securities,
+    std::string_view code)
+  {
+    return securities != nullptr ? securities->intern(code) : noSecurityId;
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,98 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// seq_locked.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// A value one thread writes and any thread reads without waiting on it.
+// The value is copied word by word through relaxed atomics between two
+// bumps of a sequence number; readers retry while it is odd or moved
+// under them. Writers must be serialized by the owner.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Seq Locked
+
+  template <typename Value>
+  class SeqLocked
+  {
+
+    static_assert(std::is_trivially_copyable_v<Value>,
+      "SeqLocked copies values as raw words");
+
+    public:
+
+      void store(const Value& value)
+      {
+        std::array<std::uint64_t, wordCount> buffer {};
+        std::memcpy(buffer.data(), &value, sizeof(Value));
+
+        const std::uint32_t sequence =
+          sequence_.load(std::memory_order_relaxed);
+
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (std::size_t i = 0; i < wordCount; ++i) {
+          words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+      }
+
+      void load(Value& value) const
+      {
+        std::array<std::uint64_t, wordCount> buffer;
+
+        for (;;) {
+          const std::uint32_t before =
+            sequence_.load(std::memory_order_acquire);
+
+          if (before & 1) {
+            continue;
+          }
+
+          for (std::size_t i = 0; i < wordCount; ++i) {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+          }
+
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (sequence_.load(std::memory_order_relaxed) == before) {
+            break;
+          }
+        }
+
+        std::memcpy(static_cast<void*>(&value), buffer.data(),
+          sizeof(Value));
+      }
+
+    private:
+
+      static constexpr std::size_t wordCount = (sizeof(Value) + 7) / 8;
+
+      // Odd while a store is in progress
+      std::atomic<std::uint32_t> sequence_ { 0 };
+
+      std::array<std::atomic<std::uint64_t>, wordCount> words_ {};
+
+  };
+
+} // Namespace FixClient
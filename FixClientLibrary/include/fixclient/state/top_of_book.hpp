@@ -0,0 +1,239 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// top_of_book.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Top of Book                                                  │░░
+//    │                                                               │░░
+//    │  - One flat row per security                                  │░░
+//    │  - Bid, Offer, Trade, Index, Open, High and Low               │░░
+//    │  - Reports only the securities whose values changed           │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Built from the MarketDataModel vectors of the MD feed. A snapshot
+// replaces every entry of its security, an incremental applies NEW,
+// CHANGE and DELETE entry by entry. Rows are a flat array indexed by
+// SecurityId; pointers find() returns stay valid until the next apply.
+//
+// Not thread safe. The engine updates it on the thread running the
+// workflow, the consumer thread under queued dispatch.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "codec/market_data.hpp"
+#include "state/security_table.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Top of Book Model
+
+  // One per FIX::MDEntryType the Market Data Codec supports
+  enum class TopOfBookEntry : std::uint8_t {
+
+    Bid,
+
+    Offer,
+
+    Trade,
+
+    Index,
+
+    Open,
+
+    High,
+
+    Low
+
+  };
+
+  constexpr std::size_t topOfBookEntryCount = 7;
+
+  // Nothing for entry types the feed does not send
+  std::optional<TopOfBookEntry> toTopOfBookEntry(char entryType);
+
+  struct TopOfBookLevel
+  {
+    // See MarketDataModel
+    double quantity { 0.0 };
+
+    double price { 0.0 };
+
+    double yield { 0.0 };
+
+    // False until set, and after a DELETE
+    bool present { false };
+
+    bool operator==(const TopOfBookLevel&) const = default;
+  };
+
+  struct TopOfBookModel
+  {
+    std::array<TopOfBookLevel, topOfBookEntryCount> levels {};
+
+    // Bit (1 << TopOfBookEntry) per level the update changed. Only
+    // set while the table reports the change.
+    std::uint8_t changed { 0 };
+
+    const TopOfBookLevel& operator[](TopOfBookEntry entry) const
+    {
+      return levels[static_cast<std::size_t>(entry)];
+    }
+
+    bool hasChanged(TopOfBookEntry entry) const
+    {
+      return changed & (1 << static_cast<int>(entry));
+    }
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Top of Book Table
+
+  class TopOfBookTable
+  {
+
+    public:
+
+      // Rows are indexed by the SecurityIds of this table. Models
+      // without one are interned here.
+      explicit TopOfBookTable(SecurityTable& securities);
+
+      // Calls onChange(securityCode, model) once per changed security,
+      // after the whole vector is applied
+      template <typename OnChange>
+      void applySnapshot(const std::vector<MarketDataModel>& data,
+        OnChange&& onChange);
+
+      template <typename OnChange>
+      void applyIncremental(const std::vector<MarketDataModel>& data,
+        OnChange&& onChange);
+
+      // Nullptr until the security got market data
+      const TopOfBookModel* find(SecurityId securityId) const;
+
+      const TopOfBookModel* find(std::string_view securityCode) const;
+
+      // Securities with market data
+      std::size_t size() const
+      {
+        return activeCount_;
+      }
+
+      void clear();
+
+    private:
+
+      SecurityId rowFor(const MarketDataModel& model);
+
+      // Applies one entry, records the change and touches the row
+      void apply(SecurityId row, const MarketDataModel& model);
+
+      void touch(SecurityId row, TopOfBookEntry entry);
+
+      template <typename OnChange>
+      void notify(OnChange&& onChange);
+
+      SecurityTable& securities_;
+
+      // Indexed by SecurityId, grown as IDs show up
+      std::vector<TopOfBookModel> rows_;
+      std::vector<std::uint8_t> active_;
+      std::size_t activeCount_ { 0 };
+
+      // Per row, so notifying never reads the security table, which
+      // belongs to the QuickFIX thread under queued dispatch
+      std::vector<std::string> codes_;
+
+      // Rows changed by the update in progress
+      std::vector<SecurityId> touched_;
+
+      // Levels a snapshot set, per row, and the rows it covered. The
+      // top bit marks a row collected, whether or not any of its entries
+      // had a level.
+      static constexpr std::uint8_t collected = 0x80;
+      static_assert(topOfBookEntryCount < 8, "Levels and collected bit");
+
+      std::vector<std::uint8_t> seen_;
+      std::vector<SecurityId> snapshotRows_;
+
+  };
+
+  template <typename OnChange>
+  void TopOfBookTable::applySnapshot(
+    const std::vector<MarketDataModel>& data, OnChange&& onChange)
+  {
+    // Levels missing from a snapshot no longer exist
+    snapshotRows_.clear();
+    for (const MarketDataModel& model : data) {
+      const SecurityId row = rowFor(model);
+      if ((seen_[row] & collected) == 0) {
+        seen_[row] |= collected;
+        snapshotRows_.push_back(row);
+      }
+
+      std::optional<TopOfBookEntry> entry = toTopOfBookEntry(model.entryType);
+      if (entry.has_value()) {
+        seen_[row] |= 1 << static_cast<int>(entry.value());
+      }
+
+      apply(row, model);
+    }
+
+    for (SecurityId row : snapshotRows_) {
+      for (std::size_t i = 0; i < topOfBookEntryCount; ++i) {
+        TopOfBookLevel& level = rows_[row].levels[i];
+        if ((seen_[row] & (1 << i)) == 0 && level.present) {
+          level = TopOfBookLevel {};
+          touch(row, static_cast<TopOfBookEntry>(i));
+        }
+      }
+      seen_[row] = 0;
+    }
+
+    notify(onChange);
+  }
+
+  template <typename OnChange>
+  void TopOfBookTable::applyIncremental(
+    const std::vector<MarketDataModel>& data, OnChange&& onChange)
+  {
+    for (const MarketDataModel& model : data) {
+      apply(rowFor(model), model);
+    }
+
+    notify(onChange);
+  }
+
+  template <typename OnChange>
+  void TopOfBookTable::notify(OnChange&& onChange)
+  {
+    for (SecurityId row : touched_) {
+      onChange(codes_[row], rows_[row]);
+      rows_[row].changed = 0;
+    }
+    touched_.clear();
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,186 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// loopback_transport.hpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Loopback Transport                                           │░░
+//    │                                                               │░░
+//    │  - Client and venue sessions in one process                   │░░
+//    │  - Messages move through a memory queue, no sockets           │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Takes the place of SocketInitiator. It creates the -MD, -OB and -TR
+// sessions of the client, initiating, and their mirror images on the
+// venue side, accepting, and connects each pair with a QuickFIX
+// Responder that queues the serialized messages for the other end.
+//
+// The sessions are real QuickFIX sessions: they log on, number and
+// parse messages as they would over TCP, and Session::sendToTarget()
+// reaches them, so OrderDispatch works unchanged. Only the kernel is
+// gone from the path, which keeps latency measurements stable.
+//
+// One thread moves the queued messages and runs the session timers.
+// Sessions are kept in memory and do not log.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "quickfix.hpp"
+
+namespace FixClient {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Loopback Options
+
+  struct LoopbackOptions
+  {
+    // FIX44.xml, QuickFIX needs it to parse the repeating groups
+    std::string dataDictionary;
+
+    // Without "-MD", "-OB" or "-TR", like the workflow's
+    std::string compId;
+
+    std::string venueId { "OPENYIELD" };
+
+    int heartBtInt { 30 };
+
+    // Busy polls the queue instead of sleeping on it. Costs a core,
+    // saves the wake up.
+    bool spin { false };
+  };
+
+  enum class LoopbackDirection : std::uint8_t {
+
+    // The venue sent it, the client session is about to parse it
+    ToClient,
+
+    // The client session just serialized it
+    FromClient
+
+  };
+
+  // Sees every message crossing the loopback, on the thread moving it,
+  // with the client's end of the session
+  using LoopbackTap = std::function<void(
+    LoopbackDirection direction,
+    const FIX::SessionID& clientSessionID,
+    const std::string& message
+  )>;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Loopback Transport
+
+  class LoopbackTransport
+  {
+
+    public:
+
+      LoopbackTransport(FIX::Application& client, FIX::Application& venue,
+        const LoopbackOptions& options, LoopbackTap tap = {});
+
+      // Stops if still running
+      ~LoopbackTransport();
+
+      LoopbackTransport(const LoopbackTransport&) = delete;
+      LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+
+      // Creates the sessions and starts logging on
+      void start();
+
+      // Logs the client out, waiting up to a second for it, then stops
+      // moving messages
+      void stop();
+
+      // True once every client session is logged on
+      bool waitForLogon(std::chrono::milliseconds timeout);
+
+      const std::vector<FIX::SessionID>& clientSessions() const
+      {
+        return clientSessions_;
+      }
+
+      // Send to these to reach the client
+      const std::vector<FIX::SessionID>& venueSessions() const
+      {
+        return venueSessions_;
+      }
+
+    private:
+
+      struct Delivery
+      {
+        FIX::Session* to;
+
+        std::string message;
+
+        // Tells the other end the connection dropped
+        bool disconnect;
+
+        // To the client, for the tap
+        const FIX::SessionID* clientSessionID;
+      };
+
+      class Pipe;
+
+      void push(Delivery&& delivery);
+
+      void run();
+
+      void deliver(Delivery& delivery);
+
+      // Logons, heartbeats and logouts
+      void tick();
+
+      bool allLoggedOn(bool loggedOn);
+
+      FIX::Application& client_;
+      FIX::Application& venue_;
+      LoopbackOptions options_;
+      LoopbackTap tap_;
+
+      std::vector<FIX::SessionID> clientSessions_;
+      std::vector<FIX::SessionID> venueSessions_;
+
+      // Declared before the sessions, which keep pointers to them
+      FIX::MemoryStoreFactory storeFactory_;
+      FIX::DataDictionaryProvider dictionaries_;
+      std::vector<std::unique_ptr<Pipe>> pipes_;
+      std::vector<std::unique_ptr<FIX::Session>> sessions_;
+
+      std::mutex mutex_;
+      std::condition_variable wake_;
+      std::deque<Delivery> queue_;
+      std::atomic<bool> pending_ { false };
+
+      std::thread thread_;
+      std::atomic<bool> running_ { false };
+
+  };
+
+} // Namespace FixClient
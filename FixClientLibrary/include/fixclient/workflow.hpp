@@ -14,16 +14,124 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "codec/market_data.hpp"
 #include "codec/session_state.hpp"
 #include "codec/execution_event.hpp"
 #include "codec/order_book.hpp"
 
+#include "model/security_model.hpp"
+
 #include "dispatch/order.hpp"
+#include "dispatch/order_submitter.hpp"
+#include "dispatch/order_throttle.hpp"
+#include "dispatch/replace_coalescer.hpp"
+#include "dispatch/risk_gate.hpp"
+
+#include "state/ioi_book.hpp"
+#include "state/order_cache.hpp"
+#include "state/top_of_book.hpp"
 
 namespace FixClient {
 
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Workflow Handler
+  //
+  // What BasicFixEngine needs from a workflow. WorkflowInterface and its
+  // subclasses satisfy it, so does any type with the same handlers.
+
+  template <typename Workflow>
+  concept WorkflowHandler = requires(
+    Workflow& workflow,
+    const std::string& code,
+    const std::vector<MarketDataModel>& marketData,
+    const IOIOrderModel& ioiOrder,
+    const SessionStateModel& sessionState,
+    const AcknowledgeEventModel& acknowledgeEvent,
+    const RejectEventModel& rejectEvent,
+    const FillEventModel& fillEvent,
+    const PostTradeEventModel& postTradeEvent
+  ) {
+    workflow.onLogon(code);
+    workflow.onLogout(code);
+    workflow.onMarketData(marketData);
+    workflow.onOIOOrderBook(ioiOrder);
+    workflow.onSessionState(sessionState);
+    workflow.onAcknowledgeEvent(code, acknowledgeEvent);
+    workflow.onRejectEvent(code, rejectEvent);
+    workflow.onFillEvent(code, fillEvent);
+    workflow.onPostTradeEvent(code, postTradeEvent);
+  };
+
+  // Optional. Workflows with onTopOfBook get the library's top of book
+  // table updates, the engine skips maintaining it for the others.
+  // WorkflowInterface has none, so FixEngine never keeps the table; run
+  // a workflow defining it with BasicFixEngine<YourWorkflow>.
+  template <typename Workflow>
+  concept TopOfBookHandler = requires(
+    Workflow& workflow,
+    const std::string& securityCode,
+    const TopOfBookModel& topOfBook
+  ) {
+    workflow.onTopOfBook(securityCode, topOfBook);
+  };
+
+  // Optional. Workflows with onIOIBook get the depth of book of a
+  // security after each IOI that changed it, the engine skips keeping
+  // the book for the others. As with onTopOfBook, not on FixEngine.
+  template <typename Workflow>
+  concept IOIBookHandler = requires(
+    Workflow& workflow,
+    const std::string& securityCode,
+    const IOISecurityBook& book
+  ) {
+    workflow.onIOIBook(securityCode, book);
+  };
+
+  // Optional. Called with the answer to requestSecurityList, after the
+  // engine interned the codes.
+  template <typename Workflow>
+  concept SecurityListHandler = requires(
+    Workflow& workflow,
+    const std::vector<SecurityModel>& securities
+  ) {
+    workflow.onSecurityList(securities);
+  };
+
+  // Optional. Workflows keeping order state, as WorkflowInterface does
+  // in its order cache and risk gate, get each execution report and
+  // session state as soon as it is decoded, before their handlers run.
+  template <typename Workflow>
+  concept OrderStateHolder = requires(
+    Workflow& workflow,
+    const ExecutionEventModel& executionEvent,
+    ExecutionEventModel& notSent,
+    const SessionStateModel& sessionState
+  ) {
+    workflow.applyExecution(executionEvent, notSent);
+    workflow.applySessionState(sessionState);
+  };
+
+  // Optional. Workflows sending through a SessionHandle, as
+  // WorkflowInterface does, get each session at logon and give it back
+  // at logout, on QuickFIX's thread before onLogon and onLogout run.
+  template <typename Workflow>
+  concept SessionHolder = requires(
+    Workflow& workflow,
+    const FIX::SessionID& sessionID
+  ) {
+    workflow.attachSession(sessionID);
+    workflow.detachSession(sessionID);
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Workflow Interface
+  //
+  // Subclass and override the handlers you need. Behind a FixEngine the
+  // handlers are called virtually. Declare the subclass `final` and run
+  // it with BasicFixEngine<YourWorkflow> to have them bound statically.
+
   class WorkflowInterface
   {
     
@@ -31,55 +139,148 @@ namespace FixClient {
     
       // Construct the interface using the provided
       // FIX Comp ID. Do not append the "-MD", "-TR", as the library knows!
-      WorkflowInterface(const std::string& compId);
+      // The order cache tracks up to orderCapacity orders, past them
+      // orders fail Untracked. The risk gate checks every order sent
+      // against risk and the throttle keeps them under the venue's
+      // message rate. submitOrder queues up to submitCapacity orders,
+      // 0 has it send inline.
+      WorkflowInterface(const std::string& compId,
+        std::size_t orderCapacity = 4096, const RiskLimits& risk = {},
+        const ThrottleLimits& throttle = {},
+        std::size_t submitCapacity = 0);
+
+      virtual ~WorkflowInterface() = default;
     
       // -------- -------- -------- --------
       // MARK: Incoming Overrides
     
       // Override this function to handle login events
-      void onLogon(const std::string& senderId) const;
+      virtual void onLogon(const std::string& senderId) const;
 
       // Override this function to handle logout events
-      void onLogout(const std::string& senderId) const;
+      virtual void onLogout(const std::string& senderId) const;
       
       // Override this to consume market data messages
-      void onMarketData(const std::vector<MarketDataModel>& model) const;
+      virtual void onMarketData(
+        const std::vector<MarketDataModel>& model) const;
 
       // Override this to consume order book depth messages
-      void onOIOOrderBook(const IOIOrderModel& model) const;
+      virtual void onOIOOrderBook(const IOIOrderModel& model) const;
+
+      // Override this to get the securities requestSecurityList asked
+      // for
+      virtual void onSecurityList(
+        const std::vector<SecurityModel>& securities) const;
 
       // Override this to capture marketplace session state
-      void onSessionState(const SessionStateModel& model) const;
+      virtual void onSessionState(const SessionStateModel& model) const;
       
       // Override the next four to handle the different
       // workflows provided by execution reports
-      void onAcknowledgeEvent(const std::string& orderCode,
+      virtual void onAcknowledgeEvent(const std::string& orderCode,
         const AcknowledgeEventModel& model) const;
 
-      void onRejectEvent(const std::string& orderCode,
+      virtual void onRejectEvent(const std::string& orderCode,
         const RejectEventModel& model) const;
 
-      void onFillEvent(const std::string& orderCode,
+      virtual void onFillEvent(const std::string& orderCode,
         const FillEventModel& model) const;
 
-      void onPostTradeEvent(const std::string& orderCode,
+      virtual void onPostTradeEvent(const std::string& orderCode,
         const PostTradeEventModel& model) const;
         
       // -------- -------- -------- --------
       // MARK: Outgoing Functions
       
-      // Place a new order, replace it or cancel it
-      void sendOrder(const OrderModel& model);
+      // Place a new order, replace it or cancel it. Anything but
+      // Passed is the risk check that blocked it, nothing was sent.
+      // A replace of an order with a replace in flight is held until
+      // the venue answers, and collapses with the ones after it; its
+      // checks run when it goes out.
+      RiskCheck sendOrder(const OrderModel& model);
       
+      // sendOrder from any number of threads without waiting on its
+      // locks. The order is queued and sent by the submitter's thread,
+      // in ticket order; a ticket not accepted means the queue was full.
+      // Orders of one chain must all go through here to keep their
+      // order.
+      SubmissionTicket submitOrder(const OrderModel& model);
+
       // Request a list of supported securities
       void requestSecurityList();
 
       // Send Cancel All
       void sendCancelAll();
 
+      // -------- -------- -------- --------
+      // MARK: Order State
+
+      // Every order sent through sendOrder, as far as the execution
+      // reports got it. Safe to read from any thread.
+      const OrderCache& orders() const
+      {
+        return orders_;
+      }
+
+      // Any thread. Limits, the kill switch and the exposure.
+      RiskGate& risk()
+      {
+        return orderDispatch_.risk();
+      }
+
+      const RiskGate& risk() const
+      {
+        return orderDispatch_.risk();
+      }
+
+      // Orders waiting for the venue's message rate, and how long
+      // they waited
+      const OrderThrottle& throttle() const
+      {
+        return orderDispatch_.throttle();
+      }
+
+      // Where the tickets are, blocked and rejected counts and the
+      // time from submitOrder until the order was sent
+      const OrderSubmitter& submitter() const
+      {
+        return submitter_;
+      }
+
+      // Called by the engine, see OrderStateHolder. Moves the order
+      // cache on, gives the risk gate back the exposure it freed and
+      // sends the replace held back for the order, if any. True when
+      // the held replace was blocked by a risk check or its send threw,
+      // with a reject for it in notSent. sendOrder() returned Passed for
+      // it, so the engine hands the reject to onRejectEvent() after the
+      // event.
+      bool applyExecution(const ExecutionEventModel& event,
+        ExecutionEventModel& notSent);
+
+      void applySessionState(const SessionStateModel& model);
+
+      // Called by the engine, see SessionHolder. Orders, security list
+      // requests and cancel alls then go to the session directly.
+      void attachSession(const FIX::SessionID& sessionID);
+
+      void detachSession(const FIX::SessionID& sessionID);
+
     private:
+
+      // sendOrder() past the coalescer
+      RiskCheck send(const OrderModel& model);
+
+      // Gives back what send() reserved for an order that was not sent
+      void sendFailed(const OrderModel& model);
     
+      // Ahead of the dispatch, whose throttle thread rolls orders back
+      // in it until the dispatch is gone
+      OrderCache orders_;
+
       OrderDispatch orderDispatch_;
+
+      // Last, its thread sends through the members above
+      OrderSubmitter submitter_;
   
   };
 
@@ -12,70 +12,90 @@
 // -------- -------- -------- -------- -------- -------- -------- --------
 
 #include "codec/execution_event.hpp"
+#include "codec/field_value.hpp"
+#include "state/security_table.hpp"
 
 namespace FixClient {
 
+  ExecutionEventCodec::ExecutionEventCodec(SecurityTable* securities) :
+    securities_(securities)
+  {
+    // Nada
+  }
+
+  namespace {
+
+    // Keeps the previous report's payload if it was of the same kind,
+    // so its strings keep their capacity
+    template <typename Payload>
+    Payload& payloadOf(ExecutionEventModel& event)
+    {
+      if (!std::holds_alternative<Payload>(event.value)) {
+        event.value.template emplace<Payload>();
+      }
+      return std::get<Payload>(event.value);
+    }
+
+  }
+
 	std::optional<ExecutionEventModel> ExecutionEventCodec::onExecutionReport(
     const FIX44::ExecutionReport& message) const
   {
-    FIX::ClOrdID clOrdId;
-    FIX::ExecType execType;
-    FIX::OrdStatus ordStatus;
-    FIX::NoPartyIDs noPartyIDs;
-    FIX44::ExecutionReport::NoPartyIDs noPartiesGroup;
-    FIX::PartyID partyId;
-    FIX::PartyRole partyRole;
+    ExecutionEventModel event;
+    if (!onExecutionReport(message, event)) {
+      return std::nullopt;
+    }
+    return event;
+  }
 
-    message.get(clOrdId);
-    message.get(execType);
-    message.get(ordStatus);
-    message.get(noPartyIDs);
+  bool ExecutionEventCodec::onExecutionReport(
+    const FIX44::ExecutionReport& message,
+    ExecutionEventModel& event) const
+  {
+    const std::string& clOrdId = stringField(message, FIX::FIELD::ClOrdID);
+    const char execType = charField(message, FIX::FIELD::ExecType);
+    const char ordStatus = charField(message, FIX::FIELD::OrdStatus);
+    const int noPartyIDs = intField(message, FIX::FIELD::NoPartyIDs);
   
     // -------- -------- -------- --------
     // MARK: Acknowledgements
     
     if (execType == FIX::ExecType_NEW) {
       if (ordStatus == FIX::OrdStatus_NEW) {
-        AcknowledgeEventModel payload = {
-          .status = "NewOrderAccepted"
-        };
-        
-        return ExecutionEventModel {
-          .orderCode = clOrdId,
-          .value = payload
-        };
+        AcknowledgeEventModel& payload =
+          payloadOf<AcknowledgeEventModel>(event);
+        payload.status = "NewOrderAccepted";
+        payload.reason.clear();
+
+        event.orderCode = clOrdId;
+        return true;
       }
     }
 
     if (execType == FIX::ExecType_CANCELED) {
       if (ordStatus == FIX::OrdStatus_CANCELED) {
-        std::string reason = "";
-        if (message.isSetField(58)) {
-          reason = message.getField(58);
+        AcknowledgeEventModel& payload =
+          payloadOf<AcknowledgeEventModel>(event);
+        payload.status = "OrderCanceled";
+        payload.reason.clear();
+        if (message.isSetField(FIX::FIELD::Text)) {
+          payload.reason = stringField(message, FIX::FIELD::Text);
         }
-        
-        AcknowledgeEventModel payload = {
-          .status = "OrderCanceled",
-          .reason = reason
-        };
-        
-        return ExecutionEventModel {
-          .orderCode = clOrdId,
-          .value = payload
-        };
+
+        event.orderCode = clOrdId;
+        return true;
       }
     }
 
     if (execType == FIX::ExecType_REPLACED) {
       if (ordStatus == FIX::OrdStatus_REPLACED) {
-        AcknowledgeEventModel payload = {
-          .status = "OrderReplaced"
-        };
-        
-        return ExecutionEventModel {
-          .orderCode = clOrdId,
-          .value = payload
-        };
+        AcknowledgeEventModel& payload =
+          payloadOf<AcknowledgeEventModel>(event);
+        payload.status = "OrderReplaced";
+        payload.reason.clear();
+
+        event.orderCode = clOrdId;
+        return true;
       }
     }
     
@@ -83,21 +103,15 @@ namespace FixClient {
     // MARK: Rejections
     
     if (execType == FIX::ExecType_REJECTED) {
-      FIX::OrdRejReason ordRejReason;
-      FIX::Text text;
-      
-      message.get(ordRejReason);
-      message.get(text);
-      
-      RejectEventModel payload = {
-        .status = ordRejReason,
-        .message = text
-      };
-      
-      return ExecutionEventModel {
-        .orderCode = clOrdId,
-        .value = payload
-      };
+      const int ordRejReason = intField(message, FIX::FIELD::OrdRejReason);
+      const std::string& text = stringField(message, FIX::FIELD::Text);
+
+      RejectEventModel& payload = payloadOf<RejectEventModel>(event);
+      payload.status = ordRejReason;
+      payload.message = text;
+
+      event.orderCode = clOrdId;
+      return true;
     }
     
     // -------- -------- -------- --------
@@ -108,7 +122,29 @@ namespace FixClient {
       if ( ordStatus == FIX::OrdStatus_PARTIALLY_FILLED
         || ordStatus == FIX::OrdStatus_FILLED
       ) {
-        FillEventModel payload;
+        // Read everything before touching the event, a missing field
+        // throws
+        const std::string& execId = stringField(message, FIX::FIELD::ExecID);
+        const std::string& securityId =
+          stringField(message, FIX::FIELD::SecurityID);
+        const char side = charField(message, FIX::FIELD::Side);
+        const double lastQty = doubleField(message, FIX::FIELD::LastQty);
+        const double lastPx = doubleField(message, FIX::FIELD::LastPx);
+        const double yield = doubleField(message, FIX::FIELD::Yield);
+        const double leavesQty = doubleField(message, FIX::FIELD::LeavesQty);
+        const double grossTradeAmt =
+          doubleField(message, FIX::FIELD::GrossTradeAmt);
+        const double accruedInterestAmt =
+          doubleField(message, FIX::FIELD::AccruedInterestAmt);
+        const double netMoney = doubleField(message, FIX::FIELD::NetMoney);
+        const std::string& settlDate =
+          stringField(message, FIX::FIELD::SettlDate);
+        const double cumQty = doubleField(message, FIX::FIELD::CumQty);
+        const double avgPx = doubleField(message, FIX::FIELD::AvgPx);
+        const std::string& transactTime =
+          stringField(message, FIX::FIELD::TransactTime);
+
+        FillEventModel& payload = payloadOf<FillEventModel>(event);
         
         if (ordStatus == FIX::OrdStatus_PARTIALLY_FILLED) {
           payload.status = "PartialFill";
@@ -116,78 +152,48 @@ namespace FixClient {
           payload.status = "CompleteFill";
         }
         
-        // Get more fields for Fills
-        FIX::ExecID execId;
-        FIX::SecurityID securityId;
-        FIX::ClOrdID clOrdId;
-        FIX::Side side;
-        FIX::LastQty lastQty;
-        FIX::LastPx lastPx;
-        FIX::Yield yield;
-        FIX::LeavesQty leavesQty;
-        FIX::GrossTradeAmt grossTradeAmt;
-        FIX::AccruedInterestAmt accruedInterestAmt;
-        FIX::NetMoney netMoney;
-        FIX::SettlDate settlDate;
-        FIX::CumQty cumQty;
-        FIX::AvgPx avgPx;
-  //      FIX::TransactTime transactTime;
-        
-        message.get(execId);
-        message.get(securityId);
-        message.get(clOrdId);
-        message.get(side);
-        message.get(lastQty);
-        message.get(lastPx);
-        message.get(yield);
-        message.get(leavesQty);
-        message.get(grossTradeAmt);
-        message.get(accruedInterestAmt);
-        message.get(netMoney);
-        message.get(settlDate);
-        message.get(cumQty);
-        message.get(avgPx);
-  //      message.get(transactTime);
-        
         payload.executionCode = execId;
         payload.securityCode = securityId;
+        payload.securityId =
+          internSecurity(securities_, payload.securityCode);
+
+        payload.contraClearingMpid.clear();
+        payload.contraClearingAccount.clear();
+        payload.executedBy.clear();
+        payload.subscriberAccount.clear();
         
         for (int i = 1; i <= noPartyIDs; i++) {
-          message.getGroup(i, noPartiesGroup);
-          noPartiesGroup.get(partyRole);
+          const FIX::FieldMap& party =
+            message.getGroupRef(i, FIX::FIELD::NoPartyIDs);
+          const int partyRole = intField(party, FIX::FIELD::PartyRole);
           
           if (partyRole == FIX::PartyRole_CONTRA_FIRM) {
-            noPartiesGroup.get(partyId);
-            payload.contraClearingMpid = partyId;
+            payload.contraClearingMpid =
+              stringField(party, FIX::FIELD::PartyID);
             
             // May not be set
-            if (noPartiesGroup.isSetField(802)) {
-              FIX::NoPartySubIDs noPartySubIds;
-              FIX44::ExecutionReport::NoPartyIDs::NoPartySubIDs
-                noPartySubIDsGroup;
-              FIX::PartySubID partySubID;
-              
-              noPartiesGroup.get(noPartySubIds);
-              if (noPartySubIds > 0) {
-                message.getGroup(1, noPartySubIDsGroup);
-                noPartySubIDsGroup.get(partySubID);
-                payload.contraClearingAccount = partySubID;
-              }
+            if (party.isSetField(FIX::FIELD::NoPartySubIDs)
+              && intField(party, FIX::FIELD::NoPartySubIDs) > 0
+            ) {
+              const FIX::FieldMap& subParty =
+                party.getGroupRef(1, FIX::FIELD::NoPartySubIDs);
+              payload.contraClearingAccount =
+                stringField(subParty, FIX::FIELD::PartySubID);
             }
           }
 
           if (partyRole == FIX::PartyRole_EXECUTING_FIRM) {
-            noPartiesGroup.get(partyId);
-            payload.executedBy = partyId;
+            payload.executedBy = stringField(party, FIX::FIELD::PartyID);
           }
 
           if (partyRole == FIX::PartyRole_CUSTOMER_ACCOUNT) {
-            noPartiesGroup.get(partyId);
-            payload.subscriberAccount = partyId;
+            payload.subscriberAccount =
+              stringField(party, FIX::FIELD::PartyID);
           }
 
         }
         
+        payload.side.clear();
         switch (side) {
           case FIX::Side_BUY:
             payload.side = "Buy";
@@ -208,12 +214,10 @@ namespace FixClient {
         payload.settlementDate = settlDate;
         payload.cumulativeQuantity = cumQty;
         payload.averagePrice = avgPx;
-        payload.executedAt = message.getField(60);
+        payload.executedAt = transactTime;
         
-        return ExecutionEventModel {
-          .orderCode = clOrdId,
-          .value = payload
-        };
+        event.orderCode = clOrdId;
+        return true;
       }
     }
     
@@ -221,65 +225,64 @@ namespace FixClient {
     // MARK: Post Trade
     
     if (execType == FIX::ExecType_TRADE_CANCEL) {
-    
-      FIX::ExecRefID execRefId;
-      message.get(execRefId);
+      const std::string& execRefId =
+        stringField(message, FIX::FIELD::ExecRefID);
+
+      PostTradeEventModel& payload = payloadOf<PostTradeEventModel>(event);
+      payload.status = "Cancel";
+      payload.executionCode = execRefId;
 
-      PostTradeEventModel payload = {
-        .status = "Cancel",
-        .executionCode = execRefId
-      };
-      
-      return ExecutionEventModel {
-        .orderCode = clOrdId,
-        .value = payload
-      };
+      // Only set for corrections
+      payload.quantity = 0.0;
+      payload.price = 0.0;
+      payload.yield = 0.0;
+      payload.principal = 0.0;
+      payload.accrued = 0.0;
+      payload.settlement = 0.0;
+
+      event.orderCode = clOrdId;
+      return true;
     }
 
     if (execType == FIX::ExecType_TRADE_CORRECT) {
-    
-      FIX::ClOrdID clOrdId;
-      FIX::ExecRefID execRefId;
-      FIX::LastQty lastQty;
-      FIX::LastPx lastPx;
-      FIX::Yield yield;
-      FIX::GrossTradeAmt grossTradeAmt;
-      FIX::AccruedInterestAmt accruedInterestAmt;
-      FIX::NetMoney netMoney;
-      
-      message.get(clOrdId);
-      message.get(execRefId);
-      message.get(lastQty);
-      message.get(lastPx);
-      message.get(yield);
-      message.get(grossTradeAmt);
-      message.get(accruedInterestAmt);
-      message.get(netMoney);
-      
-      PostTradeEventModel payload = {
-        .status = "Cancel",
-        .executionCode = execRefId,
-        .quantity = lastQty,
-        .price = lastPx,
-        .yield = yield,
-        .principal = grossTradeAmt,
-        .accrued = accruedInterestAmt,
-        .settlement = netMoney
-      };
-      
-      return ExecutionEventModel {
-        .orderCode = clOrdId,
-        .value = payload
-      };
+      const std::string& execRefId =
+        stringField(message, FIX::FIELD::ExecRefID);
+      const double lastQty = doubleField(message, FIX::FIELD::LastQty);
+      const double lastPx = doubleField(message, FIX::FIELD::LastPx);
+      const double yield = doubleField(message, FIX::FIELD::Yield);
+      const double grossTradeAmt =
+        doubleField(message, FIX::FIELD::GrossTradeAmt);
+      const double accruedInterestAmt =
+        doubleField(message, FIX::FIELD::AccruedInterestAmt);
+      const double netMoney = doubleField(message, FIX::FIELD::NetMoney);
 
+      PostTradeEventModel& payload = payloadOf<PostTradeEventModel>(event);
+      payload.status = "Correct";
+      payload.executionCode = execRefId;
+      payload.quantity = lastQty;
+      payload.price = lastPx;
+      payload.yield = yield;
+      payload.principal = grossTradeAmt;
+      payload.accrued = accruedInterestAmt;
+      payload.settlement = netMoney;
+
+      event.orderCode = clOrdId;
+      return true;
     }
 
-    log_.logCritic(
-      "Execution Report Not Handled! " + message.toString()
-    );
+    if (unhandledLimiter_.allow()) {
+      log_.logCritic(
+        "Execution Report Not Handled! {}",
+        FixMessageText { message }
+      );
+
+      if (std::uint64_t suppressed = unhandledLimiter_.takeSuppressed()) {
+        log_.logCritic("{} unhandled Execution Reports not shown", suppressed);
+      }
+    }
     
     // No event to return
-    return std::nullopt;
+    return false;
 
   }
   
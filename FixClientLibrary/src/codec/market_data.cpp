@@ -18,43 +18,18 @@ namespace FixClient {
 // -------- -------- -------- -------- -------- -------- -------- --------
 // MARK: Market Data Codec
 
+  MarketDataCodec::MarketDataCodec(SecurityTable* securities) :
+    securities_(securities)
+  {
+    // Nada
+  }
+
   std::vector<MarketDataModel>
   MarketDataCodec::onMarketDataSnapshotFullRefresh(
     const FIX44::MarketDataSnapshotFullRefresh& message) const
   {
     std::vector<MarketDataModel> data;
-    
-    FIX::SecurityID securityId;
-    message.get(securityId);
-
-    FIX::NoMDEntries noMDEntries;
-    message.get(noMDEntries);
-
-    FIX44::MarketDataSnapshotFullRefresh::NoMDEntries group;
-    FIX::MDEntryType mdEntryType;
-    FIX::MDEntryPx mdEntryPx;
-    FIX::MDEntrySize mdEntrySize;
-    FIX::PriceDelta priceDelta;
-
-    for (auto i = 1; i <= noMDEntries; ++i) {
-      message.getGroup(i, group);
-
-      group.get(mdEntryType);
-      group.get(mdEntryPx);
-      group.get(mdEntrySize);
-      group.get(priceDelta);
-
-      data.push_back( MarketDataModel {
-        .action = FIX::MDUpdateAction_NEW,
-        .entryType = mdEntryType,
-        .securityCode = securityId,
-        .quantity = mdEntrySize,
-        .price = mdEntryPx,
-        .yield = priceDelta
-      });
-      
-    }
-    
+    onMarketDataSnapshotFullRefresh(message, data);
     return data;
   }
 
@@ -63,41 +38,26 @@ namespace FixClient {
     const FIX44::MarketDataIncrementalRefresh& message) const
   {
     std::vector<MarketDataModel> data;
-    
-    FIX::NoMDEntries noMDEntries;
-    message.get(noMDEntries);
-
-    FIX44::MarketDataIncrementalRefresh::NoMDEntries group;
-    FIX::MDUpdateAction mdUpdateAction;
-    FIX::SecurityID securityId;
-    FIX::MDEntryType mdEntryType;
-    FIX::MDEntryPx mdEntryPx;
-    FIX::MDEntrySize mdEntrySize;
-    FIX::PriceDelta priceDelta;
-
-    for (auto i = 1; i <= noMDEntries; ++i) {
-      message.getGroup(i, group);
-
-      group.get(mdUpdateAction);
-      group.get(securityId);
-      group.get(mdEntryType);
-      group.get(mdEntryPx);
-      group.get(mdEntrySize);
-      group.get(priceDelta);
-
-      data.push_back( MarketDataModel {
-        .action = mdUpdateAction,
-        .entryType = mdEntryType,
-        .securityCode = securityId,
-        .quantity = mdEntrySize,
-        .price = mdEntryPx,
-        .yield = priceDelta
-      });
-      
-    }
-    
+    onMarketDataIncrementalRefresh(message, data);
     return data;
   }
 
+  void MarketDataCodec::onMarketDataSnapshotFullRefresh(
+    const FIX44::MarketDataSnapshotFullRefresh& message,
+    std::vector<MarketDataModel>& data) const
+  {
+    ModelWriter<MarketDataModel> writer(data);
+    onMarketDataSnapshotFullRefresh(message, writer);
+    writer.finish();
+  }
+
+  void MarketDataCodec::onMarketDataIncrementalRefresh(
+    const FIX44::MarketDataIncrementalRefresh& message,
+    std::vector<MarketDataModel>& data) const
+  {
+    ModelWriter<MarketDataModel> writer(data);
+    onMarketDataIncrementalRefresh(message, writer);
+    writer.finish();
+  }
 
 } // Namespace FixClient
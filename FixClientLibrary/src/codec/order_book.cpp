@@ -11,31 +11,38 @@
 //
 // -------- -------- -------- -------- -------- -------- -------- --------
 
+#include "codec/field_value.hpp"
 #include "codec/order_book.hpp"
+#include "state/security_table.hpp"
 
 namespace FixClient {
 
-  IOIOrderModel OrderBookCodec::onIOI(const FIX44::IOI& message) const
+  OrderBookCodec::OrderBookCodec(SecurityTable* securities) :
+    securities_(securities)
   {
-    FIX::IOIID ioiId;
-    FIX::IOITransType ioiTransType;
-    FIX::SecurityID securityId;
-    FIX::Side side;
-    FIX::IOIQty ioiQuantity;
-    FIX::Price price;
-    FIX::Yield yield;
-    FIX::IOIQltyInd ioiQltyInd;
+    // Nada
+  }
 
-    message.get(ioiId);
-    message.get(ioiTransType);
-    message.get(securityId);
-    message.get(side);
-    message.get(ioiQuantity);
-    message.get(price);
-    message.get(yield);
-    message.get(ioiQltyInd);
-    
+  IOIOrderModel OrderBookCodec::onIOI(const FIX44::IOI& message) const
+  {
     IOIOrderModel model;
+    onIOI(message, model);
+    return model;
+  }
+
+  void OrderBookCodec::onIOI(const FIX44::IOI& message,
+    IOIOrderModel& model) const
+  {
+    const std::string& ioiId = stringField(message, FIX::FIELD::IOIID);
+    const char ioiTransType = charField(message, FIX::FIELD::IOITransType);
+    const std::string& securityId =
+      stringField(message, FIX::FIELD::SecurityID);
+    const char side = charField(message, FIX::FIELD::Side);
+    const std::string& ioiQuantity =
+      stringField(message, FIX::FIELD::IOIQty);
+    const double price = doubleField(message, FIX::FIELD::Price);
+    const double yield = doubleField(message, FIX::FIELD::Yield);
+    const char ioiQltyInd = charField(message, FIX::FIELD::IOIQltyInd);
     
     model.ioiCode = ioiId;
     
@@ -48,6 +55,7 @@ namespace FixClient {
     }
 
     model.securityCode = securityId;
+    model.securityId = internSecurity(securities_, model.securityCode);
     
     model.bidOrOffer = "Offer";
     if (side == FIX::Side_BUY) {
@@ -71,8 +79,6 @@ namespace FixClient {
     if (ioiQltyInd == FIX::IOIQltyInd_MEDIUM) {
       model.isMine = "MaybeMine";
     }
-    
-    return model;
   }
 
 } // Namespace FixClient
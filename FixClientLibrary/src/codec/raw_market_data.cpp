@@ -0,0 +1,170 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// raw_market_data.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include "codec/field_value.hpp"
+#include "codec/raw_field.hpp"
+#include "codec/raw_market_data.hpp"
+#include "state/security_table.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    // One bit per field the cracked codec reads with group.get()
+    enum EntryField : unsigned {
+      HasUpdateAction = 1 << 0,
+      HasSecurityId = 1 << 1,
+      HasEntryType = 1 << 2,
+      HasEntryPx = 1 << 3,
+      HasEntrySize = 1 << 4,
+      HasPriceDelta = 1 << 5,
+      HasAll = (1 << 6) - 1
+    };
+
+    // Same order as MarketDataCodec reads them, so the same
+    // FieldNotFound is thrown for an incomplete entry
+    void requireAll(unsigned seen)
+    {
+      if (seen == HasAll) {
+        return;
+      }
+
+      if (!(seen & HasUpdateAction)) {
+        throw FIX::FieldNotFound(FIX::FIELD::MDUpdateAction);
+      }
+      if (!(seen & HasSecurityId)) {
+        throw FIX::FieldNotFound(FIX::FIELD::SecurityID);
+      }
+      if (!(seen & HasEntryType)) {
+        throw FIX::FieldNotFound(FIX::FIELD::MDEntryType);
+      }
+      if (!(seen & HasEntryPx)) {
+        throw FIX::FieldNotFound(FIX::FIELD::MDEntryPx);
+      }
+      if (!(seen & HasEntrySize)) {
+        throw FIX::FieldNotFound(FIX::FIELD::MDEntrySize);
+      }
+      throw FIX::FieldNotFound(FIX::FIELD::PriceDelta);
+    }
+
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Raw Market Data Codec
+
+  RawMarketDataCodec::RawMarketDataCodec(SecurityTable* securities) :
+    securities_(securities)
+  {
+    // Nada
+  }
+
+  std::vector<MarketDataModel>
+  RawMarketDataCodec::onMarketDataIncrementalRefresh(
+    std::string_view message) const
+  {
+    std::vector<MarketDataModel> data;
+    onMarketDataIncrementalRefresh(message, data);
+    return data;
+  }
+
+  void RawMarketDataCodec::onMarketDataIncrementalRefresh(
+    std::string_view message,
+    std::vector<MarketDataModel>& data) const
+  {
+    ModelWriter<MarketDataModel> writer(data);
+
+    RawFieldReader reader(message);
+    RawField field;
+
+    // Skip the header up to the repeating group
+    bool foundGroup = false;
+    while (reader.next(field)) {
+      if (field.tag == FIX::FIELD::NoMDEntries) {
+        data.reserve(rawToInt(field));
+        foundGroup = true;
+        break;
+      }
+    }
+
+    if (!foundGroup) {
+      throw FIX::FieldNotFound(FIX::FIELD::NoMDEntries);
+    }
+
+    MarketDataModel entry {};
+    unsigned seen = 0;
+    bool inEntry = false;
+
+    while (reader.next(field)) {
+      switch (field.tag) {
+
+        // The delimiter starts the next entry
+        case FIX::FIELD::MDUpdateAction:
+          if (inEntry) {
+            requireAll(seen);
+            writer(entry);
+          }
+          inEntry = true;
+          seen = HasUpdateAction;
+          entry.action = rawToChar(field);
+          break;
+
+        case FIX::FIELD::SecurityID:
+          seen |= HasSecurityId;
+          entry.securityCode.assign(field.value);
+          entry.securityId = internSecurity(securities_, field.value);
+          break;
+
+        case FIX::FIELD::MDEntryType:
+          seen |= HasEntryType;
+          entry.entryType = rawToChar(field);
+          break;
+
+        case FIX::FIELD::MDEntryPx:
+          seen |= HasEntryPx;
+          entry.price = rawToDouble(field);
+          break;
+
+        case FIX::FIELD::MDEntrySize:
+          seen |= HasEntrySize;
+          entry.quantity = rawToDouble(field);
+          break;
+
+        case FIX::FIELD::PriceDelta:
+          seen |= HasPriceDelta;
+          entry.yield = rawToDouble(field);
+          break;
+
+        case FIX::FIELD::CheckSum:
+          if (inEntry) {
+            requireAll(seen);
+            writer(entry);
+          }
+          writer.finish();
+          return;
+
+        default:
+          // Not decoded by MarketDataCodec either
+          break;
+      }
+    }
+
+    // Buffer without a trailer
+    if (inEntry) {
+      requireAll(seen);
+      writer(entry);
+    }
+
+    writer.finish();
+  }
+
+} // Namespace FixClient
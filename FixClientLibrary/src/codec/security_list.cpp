@@ -20,44 +20,18 @@ namespace FixClient {
   ) const
   {
     std::vector<SecurityModel> data;
-    
-    FIX::SecurityReqID securityReqID;
-    FIX::SecurityResponseID securityResponseID;
-    
-    message.get(securityReqID);
-    message.get(securityResponseID);
-
-    if (message.isSetField(FIX::FIELD::NoRelatedSym)) {
-      FIX::NoRelatedSym noRelatedSym;
-      message.get(noRelatedSym);
-      
-      FIX44::SecurityList::NoRelatedSym symGroup;
-      FIX::Symbol symbol;
-      FIX::SecurityID secID;
-      FIX::SecurityIDSource source;
-      
-      for (int i = 1; i <= noRelatedSym; ++i)
-      {
-        message.getGroup(i, symGroup);
-        symGroup.get(symbol);
-        symGroup.get(secID);
-        symGroup.get(source);
-        
-        SecurityCodeKind kind = (
-          source == FIX::SecurityIDSource_ISIN_NUMBER
-            ? SecurityCodeKind::ISIN
-            : SecurityCodeKind::CUSIP
-        );
-        
-        data.push_back(SecurityModel {
-          .code = secID,
-          .kind = kind
-        });
-      }
-    }
-    
+    onSecurityList(message, data);
     return data;
   }
-	
+
+  void SecurityCodec::onSecurityList(
+    const FIX44::SecurityList& message,
+    std::vector<SecurityModel>& data
+  ) const
+  {
+    ModelWriter<SecurityModel> writer(data);
+    onSecurityList(message, writer);
+    writer.finish();
+  }
 
 } // Namespace FixClient
@@ -11,19 +11,75 @@
 //
 // -------- -------- -------- -------- -------- -------- -------- --------
 
-#include <fmt/core.h>
-
 #include "dispatch/order.hpp"
+#include "dispatch/order_throttle.hpp"
+#include "dispatch/replace_coalescer.hpp"
+#include "dispatch/risk_gate.hpp"
 
 namespace FixClient {
 
 	OrderDispatch::OrderDispatch(
     const std::string& senderCompId
   ) :
-    senderCompId_(senderCompId + "-TR")
+    OrderDispatch(senderCompId, RiskLimits {})
   {}
+
+  OrderDispatch::OrderDispatch(
+    const std::string& senderCompId,
+    const RiskLimits& limits
+  ) :
+    OrderDispatch(senderCompId, limits, ThrottleLimits {})
+  {}
+
+  OrderDispatch::OrderDispatch(
+    const std::string& senderCompId,
+    const RiskLimits& limits,
+    const ThrottleLimits& throttle
+  ) :
+    senderCompId_(senderCompId + "-TR"),
+    session_(senderCompId_),
+    risk_(std::make_unique<RiskGate>(limits)),
+    replaces_(std::make_unique<ReplaceCoalescer>()),
+    throttle_(std::make_unique<OrderThrottle>(throttle,
+      [this](const OrderModel& model) { send(model); },
+      [this](const OrderModel& model) {
+        if (queuedSendFailed_) {
+          queuedSendFailed_(model);
+        }
+      }
+    ))
+  {}
+
+  OrderDispatch::~OrderDispatch() = default;
   
-  void OrderDispatch::sendOrder(const OrderModel& model)
+  RiskCheck OrderDispatch::sendOrder(const OrderModel& model,
+    double exposureChange, bool tracked)
+  {
+    const RiskCheck result = risk_->check(model, exposureChange, tracked);
+
+    if (result != RiskCheck::Passed) {
+      if (blockedLimiter_.allow()) {
+        log_.logWarning("Order {} blocked: {}", model.orderCode,
+          toString(result));
+      }
+      return result;
+    }
+
+    if (throttle_->submit(model) == ThrottleResult::QueueFull) {
+      // Never sent, the exposure the gate reserved is free again
+      risk_->adjust(model.security.code, -exposureChange);
+
+      if (blockedLimiter_.allow()) {
+        log_.logWarning("Order {} blocked: throttle queue full",
+          model.orderCode);
+      }
+      return RiskCheck::MessageRate;
+    }
+
+    return result;
+  }
+
+  void OrderDispatch::send(const OrderModel& model)
   {
     switch (model.action) {
       case OrderAction::New:
@@ -40,7 +96,9 @@ namespace FixClient {
     }
   }
   
-  void OrderDispatch::sendNewOrder(const OrderModel& model)
+  FIX44::NewOrderSingle OrderDispatch::newOrderMessage(
+    const OrderModel& model
+  ) const
   {
     FIX::Side side = (
       model.side == OrderSide::Sell ? FIX::Side_SELL : FIX::Side_BUY
@@ -79,17 +137,23 @@ namespace FixClient {
     message.set(FIX::PriceType(FIX::PriceType_PERCENTAGE));
     message.set(FIX::Price(model.price));
 
-    FIX::Session::sendToTarget(message,
-      FIX::SenderCompID(senderCompId_),
-      FIX::TargetCompID("OPENYIELD-TR")
-    );
+    return message;
+  }
+
+  void OrderDispatch::sendNewOrder(const OrderModel& model)
+  {
+    FIX44::NewOrderSingle message = newOrderMessage(model);
+
+    session_.send(message);
     
     log_.logDebug(
-      fmt::format("NEW Order to {}: {}", senderCompId_, message.toString())
+      "NEW Order to {}: {}", senderCompId_, FixMessageText { message }
     );
   }
 
-  void OrderDispatch::sendReplaceOrder(const OrderModel& model)
+  FIX44::OrderCancelReplaceRequest OrderDispatch::replaceOrderMessage(
+    const OrderModel& model
+  ) const
   {
     FIX::Side side = (
       model.side == OrderSide::Sell ? FIX::Side_SELL : FIX::Side_BUY
@@ -129,17 +193,23 @@ namespace FixClient {
     message.set(FIX::PriceType(FIX::PriceType_PERCENTAGE));
     message.set(FIX::Price(model.price));
 
-    FIX::Session::sendToTarget(message,
-      FIX::SenderCompID(senderCompId_),
-      FIX::TargetCompID("OPENYIELD-TR")
-    );
+    return message;
+  }
+
+  void OrderDispatch::sendReplaceOrder(const OrderModel& model)
+  {
+    FIX44::OrderCancelReplaceRequest message = replaceOrderMessage(model);
+
+    session_.send(message);
     
     log_.logDebug(
-      fmt::format("REPLACE Order to {}: {}", senderCompId_, message.toString())
+      "REPLACE Order to {}: {}", senderCompId_, FixMessageText { message }
     );
   }
   
-  void OrderDispatch::sendCancelOrder(const OrderModel &model)
+  FIX44::OrderCancelReplaceRequest OrderDispatch::cancelOrderMessage(
+    const OrderModel& model
+  ) const
   {
     FIX::Side side = (
       model.side == OrderSide::Sell ? FIX::Side_SELL : FIX::Side_BUY
@@ -176,13 +246,17 @@ namespace FixClient {
     
     message.set(FIX::OrderQty(0));
 
-    FIX::Session::sendToTarget(message,
-      FIX::SenderCompID(senderCompId_),
-      FIX::TargetCompID("OPENYIELD-TR")
-    );
+    return message;
+  }
+
+  void OrderDispatch::sendCancelOrder(const OrderModel& model)
+  {
+    FIX44::OrderCancelReplaceRequest message = cancelOrderMessage(model);
+
+    session_.send(message);
     
     log_.logDebug(
-      fmt::format("CANCEL Order to {}: {}", senderCompId_, message.toString())
+      "CANCEL Order to {}: {}", senderCompId_, FixMessageText { message }
     );
 
   }
@@ -0,0 +1,129 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_submitter.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <exception>
+
+#include "dispatch/order_submitter.hpp"
+#include "dispatch/risk_gate.hpp"
+
+namespace FixClient {
+
+  OrderSubmitter::OrderSubmitter(std::size_t capacity,
+    OrderSubmission send) :
+    send_(std::move(send))
+  {
+    if (capacity > 0) {
+      queue_ = std::make_unique<MpscQueue<Submission>>(capacity);
+      thread_ = std::thread(&OrderSubmitter::run, this);
+    }
+  }
+
+  OrderSubmitter::~OrderSubmitter()
+  {
+    running_.store(false, std::memory_order_release);
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Submit
+
+  SubmissionTicket OrderSubmitter::submit(const OrderModel& model)
+  {
+    if (!queue_) {
+      Submission submission { .model = model };
+      sendOne(submission, 0);
+      return SubmissionTicket {
+        .sequence = completed_.fetch_add(1, std::memory_order_acq_rel) + 1
+      };
+    }
+
+    Submission submission {
+      .model = model,
+      .submittedAt = Clock::now()
+    };
+
+    std::size_t position = 0;
+    if (!queue_->tryPush(submission, position)) {
+      rejected_.fetch_add(1, std::memory_order_relaxed);
+      return SubmissionTicket {};
+    }
+
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+
+    return SubmissionTicket { .sequence = position + 1 };
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Sender Thread
+
+  void OrderSubmitter::run()
+  {
+    Submission submission;
+    std::size_t position = 0;
+
+    for (;;) {
+      // Before looking, so a submit() after the look wakes the wait
+      const std::uint32_t seen = signal_.load(std::memory_order_acquire);
+
+      if (queue_->tryPop(submission, position)) {
+        sendOne(submission, position + 1);
+        continue;
+      }
+
+      // Claimed but not published yet, the producer is mid write
+      if (!queue_->empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      if (!running_.load(std::memory_order_acquire)) {
+        return;
+      }
+
+      signal_.wait(seen, std::memory_order_acquire);
+    }
+  }
+
+  void OrderSubmitter::sendOne(const Submission& submission,
+    std::uint64_t sequence)
+  {
+    try {
+      if (send_(submission.model) != RiskCheck::Passed) {
+        blocked_.fetch_add(1, std::memory_order_relaxed);
+      }
+    } catch (const std::exception& e) {
+      blocked_.fetch_add(1, std::memory_order_relaxed);
+      log_.logError("Submitted order {} not sent: {}",
+        submission.model.orderCode, e.what());
+    }
+
+    // Inline sends are neither timed nor sequenced here
+    if (sequence == 0) {
+      return;
+    }
+
+    submitTime_.record(static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - submission.submittedAt
+      ).count()
+    ));
+    completed_.store(sequence, std::memory_order_release);
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,199 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_throttle.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <exception>
+
+#include "dispatch/order_throttle.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    std::size_t indexOf(OrderAction action)
+    {
+      return static_cast<std::size_t>(action);
+    }
+
+  }
+
+  OrderThrottle::OrderThrottle(const ThrottleLimits& limits,
+    OrderSender send, OrderSender failed) :
+    limits_(limits),
+    capacity_(limits.burst > 0 ? limits.burst : limits.messagesPerSecond),
+    send_(std::move(send)),
+    failed_(std::move(failed)),
+    tokens_(capacity_),
+    refilledAt_(Clock::now())
+  {
+    if (limits_.messagesPerSecond > 0) {
+      thread_ = std::thread(&OrderThrottle::run, this);
+    }
+  }
+
+  OrderThrottle::~OrderThrottle()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_ = false;
+    }
+
+    wake_.notify_one();
+
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Submit
+
+  ThrottleResult OrderThrottle::submit(const OrderModel& model)
+  {
+    if (limits_.messagesPerSecond == 0) {
+      send_(model);
+      return ThrottleResult::Sent;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    const Clock::time_point now = Clock::now();
+    refill(now);
+
+    // Nothing waiting to be overtaken
+    if (queued_ == 0 && tokens_ >= 1.0) {
+      tokens_ -= 1.0;
+      queuedTime_[indexOf(model.action)].record(0);
+      send_(model);
+      return ThrottleResult::Sent;
+    }
+
+    if (queued_ == limits_.queueCapacity) {
+      return ThrottleResult::QueueFull;
+    }
+
+    queueOf(model).push_back(QueuedOrder { model, now });
+    ++queued_;
+
+    lock.unlock();
+    wake_.notify_one();
+
+    return ThrottleResult::Queued;
+  }
+
+  std::size_t OrderThrottle::queued() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queued_;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Queues
+
+  void OrderThrottle::refill(Clock::time_point now)
+  {
+    const double elapsed =
+      std::chrono::duration<double>(now - refilledAt_).count();
+
+    tokens_ = std::min(capacity_,
+      tokens_ + elapsed * limits_.messagesPerSecond);
+    refilledAt_ = now;
+  }
+
+  std::deque<OrderThrottle::QueuedOrder>& OrderThrottle::queueOf(
+    const OrderModel& model)
+  {
+    if (model.action != OrderAction::New) {
+      for (std::deque<QueuedOrder>& queue : queues_) {
+        const bool changesQueued = std::any_of(queue.begin(), queue.end(),
+          [&model](const QueuedOrder& order) {
+            return order.model.orderCode == model.originalOrderCode;
+          }
+        );
+
+        if (changesQueued) {
+          return queue;
+        }
+      }
+    }
+
+    return queues_[indexOf(model.action)];
+  }
+
+  std::deque<OrderThrottle::QueuedOrder>* OrderThrottle::nextQueue()
+  {
+    for (OrderAction action : {
+      OrderAction::Cancel, OrderAction::Replace, OrderAction::New
+    }) {
+      if (!queues_[indexOf(action)].empty()) {
+        return &queues_[indexOf(action)];
+      }
+    }
+
+    return nullptr;
+  }
+
+  void OrderThrottle::run()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (running_) {
+      std::deque<QueuedOrder>* queue = nextQueue();
+      if (queue == nullptr) {
+        wake_.wait(lock);
+        continue;
+      }
+
+      const Clock::time_point now = Clock::now();
+      refill(now);
+
+      // Until the next token, or a new order or the destructor wakes us
+      if (tokens_ < 1.0) {
+        wake_.wait_for(lock, std::chrono::duration<double>(
+          (1.0 - tokens_) / limits_.messagesPerSecond
+        ));
+        continue;
+      }
+
+      tokens_ -= 1.0;
+
+      const QueuedOrder order = std::move(queue->front());
+      queue->pop_front();
+      --queued_;
+
+      queuedTime_[indexOf(order.model.action)].record(
+        static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now - order.queuedAt
+          ).count()
+        )
+      );
+
+      try {
+        send_(order.model);
+      } catch (const std::exception& e) {
+        log_.logError("Queued order {} not sent: {}", order.model.orderCode,
+          e.what());
+        if (failed_) {
+          failed_(order.model);
+        }
+      }
+    }
+
+    if (queued_ > 0) {
+      log_.logWarning("Order throttle stopped, {} queued orders dropped",
+        queued_);
+    }
+  }
+
+} // Namespace FixClient
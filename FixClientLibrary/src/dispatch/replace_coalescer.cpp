@@ -0,0 +1,157 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// replace_coalescer.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include "dispatch/replace_coalescer.hpp"
+
+namespace FixClient {
+
+  Coalesced ReplaceCoalescer::submit(const OrderModel& model,
+    std::string& originalOrderCode)
+  {
+    if (model.action == OrderAction::New) {
+      return Coalesced::Send;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto found = chains_.find(std::string_view(model.originalOrderCode));
+
+    if (found == chains_.end()) {
+      if (model.action == OrderAction::Replace) {
+        auto chain = std::make_shared<Chain>();
+        chain->working = model.originalOrderCode;
+        chain->inFlight = model.orderCode;
+
+        map(model.originalOrderCode, chain);
+        map(model.orderCode, chain);
+        ++inFlight_;
+      }
+      return Coalesced::Send;
+    }
+
+    // Kept, map() may rehash
+    const std::shared_ptr<Chain> chain = found->second;
+
+    if (model.action == OrderAction::Replace) {
+      chain->amendment = model;
+      chain->hasAmendment = true;
+      map(model.orderCode, chain);
+      return Coalesced::Held;
+    }
+
+    // A cancel, nothing held is worth sending anymore
+    chain->hasAmendment = false;
+
+    if ( chain->working == model.originalOrderCode
+      || chain->inFlight == model.originalOrderCode
+    ) {
+      return Coalesced::Send;
+    }
+
+    // The venue never saw the held code
+    originalOrderCode = chain->inFlight;
+    return Coalesced::Rerouted;
+  }
+
+  bool ReplaceCoalescer::onExecution(const ExecutionEventModel& event,
+    OrderModel& amendment)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto found = chains_.find(std::string_view(event.orderCode));
+    if ( found == chains_.end()
+      || found->second->inFlight != event.orderCode
+    ) {
+      return false;
+    }
+
+    const std::shared_ptr<Chain> chain = found->second;
+
+    if (const auto* model = std::get_if<AcknowledgeEventModel>(&event.value)) {
+      if (model->status == "OrderCanceled") {
+        release(*chain);
+        return false;
+      }
+      if (model->status != "OrderReplaced") {
+        return false;
+      }
+      chain->working = chain->inFlight;
+    } else if (!std::holds_alternative<RejectEventModel>(event.value)) {
+      return false;
+    }
+
+    if (!chain->hasAmendment) {
+      release(*chain);
+      return false;
+    }
+
+    amendment = std::move(chain->amendment);
+    amendment.originalOrderCode = chain->working;
+    chain->hasAmendment = false;
+    chain->inFlight = amendment.orderCode;
+    return true;
+  }
+
+  void ReplaceCoalescer::onSendFailed(const OrderModel& model)
+  {
+    if (model.action != OrderAction::Replace) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const auto found = chains_.find(std::string_view(model.orderCode));
+    if ( found == chains_.end()
+      || found->second->inFlight != model.orderCode
+    ) {
+      return;
+    }
+
+    const std::shared_ptr<Chain> chain = found->second;
+
+    if (chain->hasAmendment) {
+      log_.logWarning("Replace {} dropped, {} was not sent",
+        chain->amendment.orderCode, model.orderCode);
+    }
+
+    release(*chain);
+  }
+
+  std::size_t ReplaceCoalescer::inFlight() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inFlight_;
+  }
+
+  void ReplaceCoalescer::map(std::string_view code,
+    const std::shared_ptr<Chain>& chain)
+  {
+    chains_.insert_or_assign(std::string(code), chain);
+    chain->codes.emplace_back(code);
+  }
+
+  void ReplaceCoalescer::release(const Chain& chain)
+  {
+    for (const std::string& code : chain.codes) {
+      const auto found = chains_.find(code);
+
+      // A later chain may have taken the code over
+      if (found != chains_.end() && found->second.get() == &chain) {
+        chains_.erase(found);
+      }
+    }
+
+    --inFlight_;
+  }
+
+} // Namespace FixClient
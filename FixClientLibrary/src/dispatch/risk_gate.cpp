@@ -0,0 +1,299 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// risk_gate.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <bit>
+#include <chrono>
+#include <functional>
+
+#include "dispatch/risk_gate.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    constexpr std::uint8_t slotEmpty = 0;
+    constexpr std::uint8_t slotClaimed = 1;
+    constexpr std::uint8_t slotReady = 2;
+
+  }
+
+  std::string_view toString(RiskCheck value)
+  {
+    switch (value) {
+      case RiskCheck::Passed: return "Passed";
+      case RiskCheck::KillSwitch: return "KillSwitch";
+      case RiskCheck::MarketplaceClosed: return "MarketplaceClosed";
+      case RiskCheck::OrderQuantity: return "OrderQuantity";
+      case RiskCheck::OrderNotional: return "OrderNotional";
+      case RiskCheck::Untracked: return "Untracked";
+      case RiskCheck::SecurityExposure: return "SecurityExposure";
+      case RiskCheck::GrossExposure: return "GrossExposure";
+      case RiskCheck::MessageRate: return "MessageRate";
+    }
+    return "";
+  }
+
+  RiskGate::RiskGate(const RiskLimits& limits) :
+    limits_(limits)
+  {
+    if (limits_.maxSecurityExposure > 0.0) {
+      const std::size_t slots = std::bit_ceil(
+        limits_.securityCapacity + limits_.securityCapacity / 3 + 1
+      );
+      securities_ = std::make_unique<ExposureSlot[]>(slots);
+      securityMask_ = slots - 1;
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Checks
+
+  RiskCheck RiskGate::check(const OrderModel& model, double exposureChange,
+    bool tracked)
+  {
+    const RiskCheck result = checkOrder(model, exposureChange, tracked);
+
+    counts_[static_cast<std::size_t>(result)].fetch_add(1,
+      std::memory_order_relaxed);
+
+    return result;
+  }
+
+  RiskCheck RiskGate::checkOrder(const OrderModel& model,
+    double exposureChange, bool tracked)
+  {
+    if (model.action != OrderAction::Cancel) {
+      if (killSwitch_.load(std::memory_order_relaxed)) {
+        return RiskCheck::KillSwitch;
+      }
+
+      if (marketplaceClosed_.load(std::memory_order_relaxed)) {
+        return RiskCheck::MarketplaceClosed;
+      }
+
+      if ( limits_.maxOrderQuantity > 0.0
+        && model.quantity > limits_.maxOrderQuantity
+      ) {
+        return RiskCheck::OrderQuantity;
+      }
+
+      if ( limits_.maxOrderNotional > 0.0
+        && notionalOf(model) > limits_.maxOrderNotional
+      ) {
+        return RiskCheck::OrderNotional;
+      }
+
+      if (!tracked) {
+        return RiskCheck::Untracked;
+      }
+    }
+
+    ExposureSlot* security = nullptr;
+    if (securities_ && exposureChange != 0.0) {
+      security = insertSlot(model.security.code);
+
+      if ( security == nullptr
+        || !reserve(security->exposure, exposureChange,
+          limits_.maxSecurityExposure)
+      ) {
+        return RiskCheck::SecurityExposure;
+      }
+    }
+
+    if (!reserve(grossExposure_, exposureChange, limits_.maxGrossExposure)) {
+      if (security != nullptr) {
+        add(security->exposure, -exposureChange);
+      }
+      return RiskCheck::GrossExposure;
+    }
+
+    if (!allowMessage()) {
+      if (security != nullptr) {
+        add(security->exposure, -exposureChange);
+      }
+      add(grossExposure_, -exposureChange);
+      return RiskCheck::MessageRate;
+    }
+
+    return RiskCheck::Passed;
+  }
+
+  void RiskGate::adjust(std::string_view securityCode, double exposureChange)
+  {
+    if (exposureChange == 0.0) {
+      return;
+    }
+
+    if (ExposureSlot* security = findSlot(securityCode)) {
+      add(security->exposure, exposureChange);
+    }
+
+    add(grossExposure_, exposureChange);
+  }
+
+  void RiskGate::onSessionState(const SessionStateModel& model)
+  {
+    marketplaceClosed_.store(
+      model.sessionState == FIX::TradSesStatus_CLOSED
+        || model.sessionState == FIX::TradSesStatus_HALTED,
+      std::memory_order_relaxed
+    );
+  }
+
+  double RiskGate::securityExposure(std::string_view securityCode) const
+  {
+    const ExposureSlot* security = findSlot(securityCode);
+    return security == nullptr
+      ? 0.0
+      : security->exposure.load(std::memory_order_relaxed);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Counters
+
+  bool RiskGate::reserve(std::atomic<double>& exposure, double change,
+    double limit)
+  {
+    double current = exposure.load(std::memory_order_relaxed);
+
+    do {
+      // Reductions always go through
+      if (limit > 0.0 && change > 0.0 && current + change > limit) {
+        return false;
+      }
+    } while (!exposure.compare_exchange_weak(current, current + change,
+      std::memory_order_relaxed));
+
+    return true;
+  }
+
+  // fetch_add on atomic<double> is missing from some standard libraries
+  void RiskGate::add(std::atomic<double>& exposure, double change)
+  {
+    double current = exposure.load(std::memory_order_relaxed);
+    while (!exposure.compare_exchange_weak(current, current + change,
+      std::memory_order_relaxed))
+    {
+      // Retry with the value another thread left
+    }
+  }
+
+  bool RiskGate::allowMessage()
+  {
+    if (limits_.maxMessagesPerSecond == 0) {
+      return true;
+    }
+
+    const auto now = static_cast<std::uint32_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+      ).count()
+    );
+
+    // A count left from an earlier second never stops a message, and a
+    // new second starts from 0 in the same swap that counts the message
+    std::uint64_t current = messageWindow_.load(std::memory_order_relaxed);
+    for (;;) {
+      const auto window = static_cast<std::uint32_t>(current >> 32);
+      const std::uint32_t messages = window == now
+        ? static_cast<std::uint32_t>(current)
+        : 0;
+
+      if (messages >= limits_.maxMessagesPerSecond) {
+        return false;
+      }
+
+      const std::uint64_t next =
+        (static_cast<std::uint64_t>(now) << 32) | (messages + 1);
+      if (messageWindow_.compare_exchange_weak(current, next,
+        std::memory_order_relaxed)
+      ) {
+        return true;
+      }
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Security Table
+
+  // Slots are claimed by a compare and swap and never freed, so a code
+  // once found stays where it is
+  RiskGate::ExposureSlot* RiskGate::findSlot(
+    std::string_view securityCode) const
+  {
+    if (!securities_) {
+      return nullptr;
+    }
+
+    const SecurityCodeString code(securityCode);
+    std::size_t slot = std::hash<std::string_view>{}(code) & securityMask_;
+
+    for (std::size_t probes = 0; probes <= securityMask_; ++probes) {
+      ExposureSlot& candidate = securities_[slot];
+      std::uint8_t state = candidate.state.load(std::memory_order_acquire);
+
+      if (state == slotEmpty) {
+        return nullptr;
+      }
+
+      // Another thread is writing the code
+      while (state == slotClaimed) {
+        state = candidate.state.load(std::memory_order_acquire);
+      }
+
+      if (candidate.securityCode == code) {
+        return &candidate;
+      }
+
+      slot = (slot + 1) & securityMask_;
+    }
+
+    return nullptr;
+  }
+
+  RiskGate::ExposureSlot* RiskGate::insertSlot(std::string_view securityCode)
+  {
+    const SecurityCodeString code(securityCode);
+    std::size_t slot = std::hash<std::string_view>{}(code) & securityMask_;
+
+    for (std::size_t probes = 0; probes <= securityMask_; ++probes) {
+      ExposureSlot& candidate = securities_[slot];
+      std::uint8_t state = candidate.state.load(std::memory_order_acquire);
+
+      if ( state == slotEmpty
+        && candidate.state.compare_exchange_strong(state, slotClaimed,
+          std::memory_order_acquire)
+      ) {
+        candidate.securityCode = code;
+        candidate.state.store(slotReady, std::memory_order_release);
+        return &candidate;
+      }
+
+      while (state == slotClaimed) {
+        state = candidate.state.load(std::memory_order_acquire);
+      }
+
+      if (candidate.securityCode == code) {
+        return &candidate;
+      }
+
+      slot = (slot + 1) & securityMask_;
+    }
+
+    if (fullLimiter_.allow()) {
+      log_.logWarning("Risk gate securities full, {} blocked", securityCode);
+    }
+    return nullptr;
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,68 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// session_handle.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include "dispatch/session_handle.hpp"
+
+namespace FixClient {
+
+  SessionHandle::SessionHandle(const std::string& senderCompId,
+    const std::string& targetCompId) :
+    senderCompId_(senderCompId),
+    targetCompId_(targetCompId)
+  {
+    // Nada
+  }
+
+  bool SessionHandle::attach(const FIX::SessionID& sessionID)
+  {
+    if (!matches(sessionID)) {
+      return false;
+    }
+
+    session_.store(FIX::Session::lookupSession(sessionID),
+      std::memory_order_release);
+    return true;
+  }
+
+  bool SessionHandle::detach(const FIX::SessionID& sessionID)
+  {
+    if (!matches(sessionID)) {
+      return false;
+    }
+
+    session_.store(nullptr, std::memory_order_release);
+    return true;
+  }
+
+  void SessionHandle::send(FIX::Message& message) const
+  {
+    if (FIX::Session* session = session_.load(std::memory_order_acquire)) {
+      session->send(message);
+      return;
+    }
+
+    FIX::Session::sendToTarget(message,
+      FIX::SenderCompID(senderCompId_),
+      FIX::TargetCompID(targetCompId_)
+    );
+  }
+
+  bool SessionHandle::matches(const FIX::SessionID& sessionID) const
+  {
+    const std::string& senderCompId = sessionID.getSenderCompID();
+    const std::string& targetCompId = sessionID.getTargetCompID();
+
+    return senderCompId == senderCompId_ && targetCompId == targetCompId_;
+  }
+
+} // Namespace FixClient
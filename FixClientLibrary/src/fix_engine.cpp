@@ -11,43 +11,143 @@
 //
 // -------- -------- -------- -------- -------- -------- -------- --------
 
-#include <regex>
-
-#include <fmt/core.h>
+#include <algorithm>
 
 #include "fix_engine.hpp"
 
 namespace FixClient {
 
-  FixEngine::FixEngine(
-    std::shared_ptr<WorkflowInterface> workflow
+  FixEngineBase::FixEngineBase(
+    MarketDataDecoder marketDataDecoder,
+    const DispatchOptions& dispatch
   ) :
-    workflow_(workflow)
+    marketDataCodec_(&securities_),
+    rawMarketDataCodec_(&securities_),
+    executionEventCodec_(&securities_),
+    orderBookCodec_(&securities_),
+    marketDataDecoder_(marketDataDecoder),
+    dispatchMode_(dispatch.mode),
+    sessionThreads_(dispatch.sessionThreads),
+    partitioner_(dispatch.securityWorkers)
   {
-    // Nada
+    std::size_t queueCount = 0;
+    switch (dispatch.mode) {
+      case EventDispatch::Inline:
+        break;
+
+      case EventDispatch::Queued:
+        queueCount = 1;
+        break;
+
+      case EventDispatch::PerSession:
+        queueCount = sessionRoleCount;
+        break;
+
+      case EventDispatch::PerSecurity:
+        queueCount = partitioner_.workers() + 1;
+        break;
+    }
+
+    const std::size_t bookCount = dispatch.mode == EventDispatch::PerSecurity
+      ? partitioner_.workers()
+      : 1;
+    for (std::size_t i = 0; i < bookCount; ++i) {
+      books_.push_back(std::make_unique<SecurityBooks>(securities_));
+    }
+
+    for (std::size_t i = 0; i < queueCount; ++i) {
+      eventQueues_.push_back(std::make_unique<EventQueue>(
+        dispatch.capacity,
+        dispatch.backpressure
+      ));
+    }
+
+    if constexpr (latencyMetricsEnabled) {
+      latencyMetrics_ = std::make_unique<LatencyMetrics>(queueCount);
+
+      // Calibrates now rather than on the first report
+      nanosecondsPerCycle();
+    }
   }
 
-// -------- -------- -------- -------- -------- -------- -------- --------
-// MARK: FIX Boilerplate
+  EventQueueStats FixEngineBase::eventQueueStats() const
+  {
+    EventQueueStats total;
+
+    for (const std::unique_ptr<EventQueue>& queue : eventQueues_) {
+      const EventQueueStats stats = queue->stats();
+      total.depth += stats.depth;
+      total.highWater = std::max(total.highWater, stats.highWater);
+      total.dropped += stats.dropped;
+      total.conflated += stats.conflated;
+    }
+
+    return total;
+  }
 
-  void FixEngine::onCreate(const FIX::SessionID& sessionID)
+  void FixEngineBase::dispatchBySecurity(const MarketDataEvent& event)
   {
-    log_.logDebug(fmt::format("[{}]/onCreate", sessionID.toStringFrozen()));
+    partitioner_.split(event.data, securityParts_);
+
+    for (std::size_t i = 0; i < securityParts_.size(); ++i) {
+      if (securityParts_[i].empty()) {
+        continue;
+      }
+
+      eventQueues_[i]->push(WorkflowEvent {
+        MarketDataEvent {
+          .data = std::move(securityParts_[i]),
+          .snapshot = event.snapshot
+        }
+      });
+      securityParts_[i].clear();
+    }
+  }
+
+  EventQueueStats FixEngineBase::eventQueueStats(SessionRole role) const
+  {
+    if (dispatchMode_ != EventDispatch::PerSession) {
+      return eventQueueStats();
+    }
+    return eventQueues_[static_cast<std::size_t>(role)]->stats();
+  }
+
+  std::vector<LatencySummary> FixEngineBase::latencySummaries() const
+  {
+    return latencyMetrics_
+      ? latencyMetrics_->summaries()
+      : std::vector<LatencySummary> {};
   }
 
-  void FixEngine::onLogon(const FIX::SessionID& sessionID)
+  void FixEngineBase::journalTo(const std::string& path)
   {
-    log_.logDebug(fmt::format("[{}]/onLogon", sessionID.toStringFrozen()));
-    workflow_->onLogon(sessionID.getSenderCompID());
+    journal_ = std::make_unique<MessageJournal>(path);
+  }
+
+  void FixEngineBase::journal(const FIX::Message& message,
+    const FIX::SessionID& sessionID)
+  {
+    if (journal_->append(message, sessionID, MessageJournal::now())) {
+      return;
+    }
+
+    if (journalLimiter_.allow()) {
+      log_.logCritic(
+        "[{}]/fromApp: Journal full, messages are lost",
+        sessionID.toStringFrozen()
+      );
+    }
   }
 
-  void FixEngine::onLogout(const FIX::SessionID& sessionID)
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: FIX Boilerplate
+
+  void FixEngineBase::onCreate(const FIX::SessionID& sessionID)
   {
-    log_.logDebug(fmt::format("[{}]/onLogout", sessionID.toStringFrozen()));
-    workflow_->onLogout(sessionID.getSenderCompID());
+    log_.logDebug("[{}]/onCreate", sessionID.toStringFrozen());
   }
 
-  void FixEngine::toAdmin(FIX::Message& message,
+  void FixEngineBase::toAdmin(FIX::Message& message,
     const FIX::SessionID& sessionID)
   {
     std::string msgType = message.getHeader().getField(FIX::FIELD::MsgType);
@@ -67,15 +167,13 @@ namespace FixClient {
     // 4 Sequence Reset
 
     log_.logDebug(
-      fmt::format(
-        "[{}]/toAdmin: {}",
-        sessionID.toStringFrozen(),
-        std::regex_replace(message.toString(), std::regex("\1"), " ")
-      )
+      "[{}]/toAdmin: {}",
+      sessionID.toStringFrozen(),
+      FixMessageText { message }
     );
   }
 
-  void FixEngine::fromAdmin(const FIX::Message& message,
+  void FixEngineBase::fromAdmin(const FIX::Message& message,
     const FIX::SessionID& sessionID)
   {
     std::string msgType = message.getHeader().getField(FIX::FIELD::MsgType);
@@ -95,85 +193,43 @@ namespace FixClient {
     // 4 Sequence Reset
 
     log_.logDebug(
-      fmt::format(
-        "[{}]/fromAdmin: {}",
-        sessionID.toStringFrozen(),
-        std::regex_replace(message.toString(), std::regex("\1"), " ")
-      )
+      "[{}]/fromAdmin: {}",
+      sessionID.toStringFrozen(),
+      FixMessageText { message }
     );
   }
 
-  void FixEngine::toApp([[maybe_unused]] FIX::Message& message,
+  void FixEngineBase::toApp([[maybe_unused]] FIX::Message& message,
     [[maybe_unused]] const FIX::SessionID& sessionID)
   {
     // Nothing here
   }
 
-  // Crack messages and pass them on to the virtual handlers below. Rejects
-  // anything else!
-  void FixEngine::fromApp(const FIX::Message& message,
-    const FIX::SessionID& sessionID)
+  void FixEngineBase::logUnsupportedMessage(const FIX::Message& message,
+    const FIX::SessionID& sessionID) const
   {
-    try {
-      crack(message, sessionID);
-    } catch (FIX::UnsupportedMessageType& e) {
-      log_.logWarning(
-        fmt::format(
-          "[{}]/fromApp: Unsupported Message: {}",
-          sessionID.toStringFrozen(),
-          std::regex_replace(message.toString(), std::regex("\1"), " ")
-        )
-      );
-    }
-  }
-  
-  void FixEngine::onMessage(
-    const FIX44::ExecutionReport& message,
-    [[ maybe_unused ]] const FIX::SessionID& session
-  )
-  {
-    std::optional<ExecutionEventModel> optionalData =
-      executionEventCodec_.onExecutionReport(message);
-      
-    if (!optionalData.has_value()) {
-      return;
-    }
-    
-    ExecutionEventModel data = optionalData.value();
-      
-    if (std::holds_alternative<AcknowledgeEventModel>(data.value)) {
-      workflow_->onAcknowledgeEvent(
-        data.orderCode,
-        std::get<AcknowledgeEventModel>(data.value)
-      );
-      return;
-    }
-
-    if (std::holds_alternative<RejectEventModel>(data.value)) {
-      workflow_->onRejectEvent(
-        data.orderCode,
-        std::get<RejectEventModel>(data.value)
-      );
+    if (!unsupportedLimiter_.allow()) {
       return;
     }
 
-    if (std::holds_alternative<FillEventModel>(data.value)) {
-      workflow_->onFillEvent(
-        data.orderCode,
-        std::get<FillEventModel>(data.value)
-      );
-      return;
-    }
+    log_.logWarning(
+      "[{}]/fromApp: Unsupported Message: {}",
+      sessionID.toStringFrozen(),
+      FixMessageText { message }
+    );
 
-    if (std::holds_alternative<PostTradeEventModel>(data.value)) {
-      workflow_->onPostTradeEvent(
-        data.orderCode,
-        std::get<PostTradeEventModel>(data.value)
+    if (std::uint64_t suppressed = unsupportedLimiter_.takeSuppressed()) {
+      log_.logWarning(
+        "[{}]/fromApp: {} unsupported messages not shown",
+        sessionID.toStringFrozen(),
+        suppressed
       );
-      return;
     }
-    
-    log_.logCritic("Unhandled Execution Event!");
   }
 
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Fix Engine
+
+  template class BasicFixEngine<WorkflowInterface>;
+
 } // Namespace FixClient
@@ -0,0 +1,108 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// journal_replay.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "journal/journal_replay.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    // A journal holds a handful of sessions, parse each once
+    const FIX::SessionID& sessionOf(
+      std::vector<std::pair<std::string, FIX::SessionID>>& sessions,
+      std::string_view text)
+    {
+      for (const auto& [key, sessionID] : sessions) {
+        if (key == text) {
+          return sessionID;
+        }
+      }
+
+      FIX::SessionID sessionID;
+      sessionID.fromString(std::string(text));
+      sessions.emplace_back(std::string(text), sessionID);
+      return sessions.back().second;
+    }
+
+    // Time between two stamps, none if the clock stepped back
+    std::chrono::nanoseconds gapBetween(std::uint64_t previous,
+      std::uint64_t current, std::chrono::nanoseconds maxGap)
+    {
+      if (current <= previous) {
+        return std::chrono::nanoseconds { 0 };
+      }
+
+      const std::uint64_t gap = current - previous;
+
+      if (gap >= static_cast<std::uint64_t>(maxGap.count())) {
+        return maxGap;
+      }
+      return std::chrono::nanoseconds(static_cast<std::int64_t>(gap));
+    }
+
+  }
+
+  ReplayStats replayJournal(MessageJournalReader& reader,
+    FIX::Application& application,
+    const FIX::DataDictionary& dictionary,
+    ReplayPace pace,
+    std::chrono::nanoseconds maxGap)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    ReplayStats stats;
+
+    std::vector<std::pair<std::string, FIX::SessionID>> sessions;
+    std::string raw;
+    FIX::Message message;
+
+    JournalRecord record;
+    std::uint64_t previousReceivedAt = 0;
+
+    const Clock::time_point start = Clock::now();
+
+    // When the current record is due, paced from the one before it
+    Clock::time_point due = start;
+
+    while (reader.next(record)) {
+      if (pace == ReplayPace::Recorded) {
+        if (stats.messages != 0) {
+          due += gapBetween(previousReceivedAt, record.receivedAt, maxGap);
+        }
+        previousReceivedAt = record.receivedAt;
+
+        std::this_thread::sleep_until(due);
+      }
+
+      ++stats.messages;
+
+      try {
+        raw.assign(record.message);
+        message.setString(raw, false, &dictionary, &dictionary);
+
+        application.fromApp(message, sessionOf(sessions, record.sessionID));
+      } catch (const FIX::Exception&) {
+        ++stats.failed;
+      }
+    }
+
+    stats.elapsed = Clock::now() - start;
+    return stats;
+  }
+
+} // Namespace FixClient
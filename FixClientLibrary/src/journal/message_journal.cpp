@@ -0,0 +1,310 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// message_journal.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "journal/message_journal.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    std::system_error systemError(const std::string& what)
+    {
+      return std::system_error(errno, std::generic_category(), what);
+    }
+
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Message Journal
+
+  MessageJournal::MessageJournal(const std::string& path,
+    std::size_t initialSize)
+  {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+      throw systemError("Cannot open journal " + path);
+    }
+
+    try {
+      struct stat status;
+      if (::fstat(fd_, &status) != 0) {
+        throw systemError("Cannot stat journal");
+      }
+
+      const auto existing = static_cast<std::size_t>(status.st_size);
+
+      // Continue after the last complete record of an earlier run,
+      // checked before the file is touched
+      if (existing > 0) {
+        char header[JournalFormat::headerSize];
+        std::size_t end = 0;
+
+        const bool isJournal = existing >= JournalFormat::headerSize
+          && ::pread(fd_, header, sizeof(header), 0)
+            == static_cast<ssize_t>(sizeof(header))
+          && std::memcmp(header, JournalFormat::magic,
+            sizeof(JournalFormat::magic)) == 0;
+
+        if (isJournal) {
+          std::memcpy(&end, header + JournalFormat::endOffset, sizeof(end));
+        }
+
+        if ( !isJournal
+          || end < JournalFormat::headerSize
+          || end > existing
+        ) {
+          throw std::runtime_error("Not a journal, not overwriting: " + path);
+        }
+
+        end_ = end;
+      }
+
+      map(std::max({ initialSize, existing, JournalFormat::headerSize }));
+
+      if (existing == 0) {
+        std::memcpy(data_, JournalFormat::magic,
+          sizeof(JournalFormat::magic));
+        std::memcpy(data_ + JournalFormat::endOffset, &end_, sizeof(end_));
+      }
+    } catch (...) {
+      unmap();
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  MessageJournal::~MessageJournal()
+  {
+    unmap();
+
+    // Nothing to do about a failure here
+    [[ maybe_unused ]] int result =
+      ::ftruncate(fd_, static_cast<off_t>(end_));
+    ::close(fd_);
+  }
+
+  bool MessageJournal::append(const FIX::Message& message,
+    const FIX::SessionID& sessionID,
+    std::uint64_t receivedAt)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    message.toString(message_);
+    sessionID_ = sessionID.toString();
+
+    return write(message_, sessionID_, receivedAt);
+  }
+
+  bool MessageJournal::append(std::string_view message,
+    std::string_view sessionID,
+    std::uint64_t receivedAt)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    return write(message, sessionID, receivedAt);
+  }
+
+  bool MessageJournal::write(std::string_view message,
+    std::string_view sessionID,
+    std::uint64_t receivedAt)
+  {
+    const std::size_t recordSize = JournalFormat::align(
+      sizeof(JournalFormat::RecordHeader) + sessionID.size() + message.size()
+    );
+
+    if (!reserve(recordSize)) {
+      return false;
+    }
+
+    const JournalFormat::RecordHeader header {
+      .sessionLength = static_cast<std::uint32_t>(sessionID.size()),
+      .messageLength = static_cast<std::uint32_t>(message.size()),
+      .receivedAt = receivedAt
+    };
+
+    char* record = data_ + end_;
+    std::memcpy(record, &header, sizeof(header));
+    record += sizeof(header);
+    std::memcpy(record, sessionID.data(), sessionID.size());
+    record += sessionID.size();
+    std::memcpy(record, message.data(), message.size());
+
+    end_ += recordSize;
+    std::memcpy(data_ + JournalFormat::endOffset, &end_, sizeof(end_));
+    return true;
+  }
+
+  std::size_t MessageJournal::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return end_;
+  }
+
+  std::uint64_t MessageJournal::now()
+  {
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+      ).count()
+    );
+  }
+
+  // Doubles the file until the record fits
+  bool MessageJournal::reserve(std::size_t bytes)
+  {
+    if (data_ && end_ + bytes <= capacity_) {
+      return true;
+    }
+
+    // Nothing mapped once growing and remapping both failed
+    const std::size_t previous = capacity_;
+    std::size_t capacity = std::max(previous, JournalFormat::headerSize);
+    while (end_ + bytes > capacity) {
+      capacity *= 2;
+    }
+
+    try {
+      unmap();
+      map(capacity);
+    } catch (const std::system_error&) {
+      // Try to keep what fits
+      try {
+        if (previous > 0) {
+          map(previous);
+        }
+      } catch (const std::system_error&) {
+        // Nada
+      }
+      return false;
+    }
+
+    return true;
+  }
+
+  void MessageJournal::map(std::size_t capacity)
+  {
+    if (::ftruncate(fd_, static_cast<off_t>(capacity)) != 0) {
+      throw systemError("Cannot grow journal");
+    }
+
+    void* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE,
+      MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+      throw systemError("Cannot map journal");
+    }
+
+    data_ = static_cast<char*>(data);
+    capacity_ = capacity;
+  }
+
+  void MessageJournal::unmap()
+  {
+    if (data_) {
+      ::munmap(data_, capacity_);
+      data_ = nullptr;
+    }
+    capacity_ = 0;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Message Journal Reader
+
+  MessageJournalReader::MessageJournalReader(const std::string& path)
+  {
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      throw systemError("Cannot open journal " + path);
+    }
+
+    struct stat status;
+    if (::fstat(fd_, &status) != 0) {
+      const std::system_error error = systemError("Cannot stat journal");
+      ::close(fd_);
+      throw error;
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ < JournalFormat::headerSize) {
+      ::close(fd_);
+      throw std::runtime_error("Not a journal: " + path);
+    }
+
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (data == MAP_FAILED) {
+      const std::system_error error = systemError("Cannot map journal");
+      ::close(fd_);
+      throw error;
+    }
+    data_ = static_cast<const char*>(data);
+
+    std::memcpy(&end_, data_ + JournalFormat::endOffset, sizeof(end_));
+
+    if ( std::memcmp(data_, JournalFormat::magic,
+          sizeof(JournalFormat::magic)) != 0
+      || end_ < JournalFormat::headerSize
+      || end_ > size_
+    ) {
+      ::munmap(const_cast<char*>(data_), size_);
+      ::close(fd_);
+      throw std::runtime_error("Not a journal: " + path);
+    }
+  }
+
+  MessageJournalReader::~MessageJournalReader()
+  {
+    ::munmap(const_cast<char*>(data_), size_);
+    ::close(fd_);
+  }
+
+  bool MessageJournalReader::next(JournalRecord& record)
+  {
+    if (position_ + sizeof(JournalFormat::RecordHeader) > end_) {
+      return false;
+    }
+
+    JournalFormat::RecordHeader header;
+    std::memcpy(&header, data_ + position_, sizeof(header));
+
+    const std::size_t recordSize = JournalFormat::align(
+      sizeof(header) + header.sessionLength + header.messageLength
+    );
+
+    if (position_ + recordSize > end_) {
+      return false;
+    }
+
+    const char* body = data_ + position_ + sizeof(header);
+    record.receivedAt = header.receivedAt;
+    record.sessionID = std::string_view(body, header.sessionLength);
+    record.message = std::string_view(
+      body + header.sessionLength,
+      header.messageLength
+    );
+
+    position_ += recordSize;
+    return true;
+  }
+
+} // Namespace FixClient
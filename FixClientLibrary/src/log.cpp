@@ -11,32 +11,70 @@
 //
 // -------- -------- -------- -------- -------- -------- -------- --------
 
+#include <chrono>
+
 #include "log.hpp"
+#include "quickfix.hpp"
 
 namespace FixClient {
 
-void Log::log(const std::string logLevel,
-  const std::string_view& logMessage) const
-{
-#ifdef SCAFFOLD
-    if (logLevel == "DEBUG") {
-      LOGDEBUG(logMessage);
-    }
-    if (logLevel == "INFO") {
-      LOGINFO(logMessage);
-    }
-    if (logLevel == "WARNING") {
-      LOGWARNING(logMessage);
-    }
-    if (logLevel == "ERROR") {
-      LOGERROR(logMessage);
-    }
-    if (logLevel == "CRITIC") {
-      LOGCRITIC(logMessage);
+  void Log::flush()
+  {
+    LogBackend::instance().flush();
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Fix Message Text
+
+  void FixMessageText::renderTo(std::string& text) const
+  {
+    message.toString(text);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Log Rate Limiter
+
+  LogRateLimiter::LogRateLimiter(std::uint32_t maxPerSecond) :
+    maxPerSecond_(maxPerSecond)
+  {
+    // Nada
+  }
+
+  bool LogRateLimiter::allow()
+  {
+    const auto now = static_cast<std::uint32_t>(
+      std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+      ).count()
+    );
+
+    // As RiskGate's message rate, a new second starts from 0 in the
+    // same swap that counts the call
+    std::uint64_t current = window_.load(std::memory_order_relaxed);
+    for (;;) {
+      const auto window = static_cast<std::uint32_t>(current >> 32);
+      const std::uint32_t count = window == now
+        ? static_cast<std::uint32_t>(current)
+        : 0;
+
+      if (count >= maxPerSecond_) {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      const std::uint64_t next =
+        (static_cast<std::uint64_t>(now) << 32) | (count + 1);
+      if (window_.compare_exchange_weak(current, next,
+        std::memory_order_relaxed)
+      ) {
+        return true;
+      }
     }
-#else
-    std::cout << logLevel << ": " << logMessage << std::endl;
-#endif
+  }
+
+  std::uint64_t LogRateLimiter::takeSuppressed()
+  {
+    return suppressed_.exchange(0, std::memory_order_relaxed);
   }
 
 } // Namespace FixClient
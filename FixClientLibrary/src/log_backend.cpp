@@ -0,0 +1,285 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// log_backend.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+
+#include "log_backend.hpp"
+
+#ifdef SCAFFOLD
+  #include <core/log/log.hpp>
+#else
+  #include <iostream>
+#endif
+
+namespace FixClient {
+
+  namespace LogDetail {
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Ring
+
+    Ring::Ring(std::size_t capacity) :
+      buffer_(new char[capacity]),
+      capacity_(capacity)
+    {
+      // Nada
+    }
+
+    bool Ring::push(const RecordHeader& header, std::string_view payload)
+    {
+      const std::size_t size = alignRecord(sizeof(header) + payload.size());
+      if (size > capacity_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+      const std::size_t position = tail & (capacity_ - 1);
+      const std::size_t remaining = capacity_ - position;
+
+      // Records do not wrap, skip the end of the buffer if needed
+      const std::size_t skip = remaining < size ? remaining : 0;
+
+      if (tail + skip + size - cachedHead_ > capacity_) {
+        cachedHead_ = head_.load(std::memory_order_acquire);
+
+        if (tail + skip + size - cachedHead_ > capacity_) {
+          dropped_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+      }
+
+      char* record = buffer_.get() + position;
+      if (skip > 0) {
+        std::memcpy(record, &padding, sizeof(padding));
+        record = buffer_.get();
+      }
+
+      RecordHeader sized = header;
+      sized.size = static_cast<std::uint32_t>(sizeof(header) + payload.size());
+      std::memcpy(record, &sized, sizeof(sized));
+      std::memcpy(record + sizeof(sized), payload.data(), payload.size());
+
+      tail_.store(tail + skip + size, std::memory_order_release);
+      return true;
+    }
+
+  } // Namespace LogDetail
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Log Backend
+
+  namespace {
+
+    // How long the backend sleeps when every ring is empty
+    constexpr auto idleWait = std::chrono::milliseconds(1);
+
+    // Marks the ring of an exiting thread, the backend drops it once
+    // it is empty
+    struct RingHandle
+    {
+      std::shared_ptr<LogDetail::Ring> ring;
+
+      ~RingHandle()
+      {
+        if (ring) {
+          ring->abandoned.store(true, std::memory_order_release);
+        }
+      }
+    };
+
+    [[maybe_unused]] std::string_view levelName(LogLevel level)
+    {
+      switch (level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warning: return "WARNING";
+        case LogLevel::Error: return "ERROR";
+        case LogLevel::Critic: return "CRITIC";
+      }
+      return "";
+    }
+
+  }
+
+  LogBackend& LogBackend::instance()
+  {
+    // Leaked on purpose, threads may still log during static destruction
+    static LogBackend* backend = new LogBackend();
+    return *backend;
+  }
+
+  LogBackend::LogBackend() :
+    thread_([this] { run(); })
+  {
+    thread_.detach();
+
+    std::atexit([] { LogBackend::instance().flush(); });
+  }
+
+  void LogBackend::push(LogLevel level, std::string_view text)
+  {
+    LogDetail::RecordHeader header {
+      .size = 0,
+      .level = level,
+      .format = nullptr,
+      .formatData = nullptr,
+      .formatSize = 0
+    };
+
+    ring().push(header, text);
+  }
+
+  void LogBackend::flush()
+  {
+    std::unique_lock lock(mutex_);
+    const std::uint64_t ticket = ++flushRequested_;
+    wake_.notify_one();
+    flushed_.wait(lock, [&] { return flushCompleted_ >= ticket; });
+  }
+
+  void LogBackend::setRingCapacity(std::size_t capacity)
+  {
+    ringCapacity_.store(
+      std::bit_ceil(std::max<std::size_t>(capacity, 4096)),
+      std::memory_order_relaxed
+    );
+  }
+
+  LogDetail::Ring& LogBackend::ring()
+  {
+    thread_local RingHandle handle;
+
+    if (!handle.ring) {
+      handle.ring = std::make_shared<LogDetail::Ring>(
+        ringCapacity_.load(std::memory_order_relaxed)
+      );
+
+      std::lock_guard lock(mutex_);
+      rings_.push_back(handle.ring);
+    }
+
+    return *handle.ring;
+  }
+
+  void LogBackend::run()
+  {
+    fmt::memory_buffer line;
+    bool unflushed = false;
+
+    while (true) {
+      std::uint64_t requested;
+      {
+        std::lock_guard lock(mutex_);
+        requested = flushRequested_;
+
+        // Forget rings of exited threads once they are drained
+        std::erase_if(rings_, [](const auto& ring) {
+          return ring->abandoned.load(std::memory_order_acquire)
+            && ring->empty();
+        });
+        draining_.assign(rings_.begin(), rings_.end());
+      }
+
+      // Everything pushed before the request has now been drained
+      const bool drained = drainAll(line) > 0;
+      unflushed = unflushed || drained;
+
+      bool completing;
+      {
+        std::lock_guard lock(mutex_);
+        completing = flushCompleted_ < requested;
+      }
+
+      // Only flush the output when asked to or when there is nothing
+      // left to write
+      if (unflushed && (completing || !drained)) {
+        flushOutput();
+        unflushed = false;
+      }
+
+      std::unique_lock lock(mutex_);
+      if (completing) {
+        flushCompleted_ = requested;
+        flushed_.notify_all();
+      }
+
+      if (!drained) {
+        wake_.wait_for(lock, idleWait, [&] {
+          return flushRequested_ != flushCompleted_;
+        });
+      }
+    }
+  }
+
+  std::size_t LogBackend::drainAll(fmt::memory_buffer& line)
+  {
+    std::size_t records = 0;
+
+    for (const auto& ring : draining_) {
+      records += ring->drain(
+        [&](const LogDetail::RecordHeader& header, std::string_view payload)
+        {
+          if (header.format == nullptr) {
+            write(header.level, payload);
+            return;
+          }
+
+          line.clear();
+          header.format(
+            std::string_view(header.formatData, header.formatSize),
+            payload.data(),
+            line
+          );
+          write(header.level, std::string_view(line.data(), line.size()));
+        }
+      );
+
+      if (const std::uint64_t dropped = ring->takeDropped()) {
+        line.clear();
+        fmt::format_to(std::back_inserter(line),
+          "Log ring full, dropped {} messages", dropped);
+        write(LogLevel::Warning, std::string_view(line.data(), line.size()));
+        ++records;
+      }
+    }
+
+    return records;
+  }
+
+  void LogBackend::write(LogLevel level, std::string_view text)
+  {
+#ifdef SCAFFOLD
+    switch (level) {
+      case LogLevel::Debug: LOGDEBUG(text); break;
+      case LogLevel::Info: LOGINFO(text); break;
+      case LogLevel::Warning: LOGWARNING(text); break;
+      case LogLevel::Error: LOGERROR(text); break;
+      case LogLevel::Critic: LOGCRITIC(text); break;
+    }
+#else
+    std::cout << levelName(level) << ": " << text << '\n';
+#endif
+  }
+
+  void LogBackend::flushOutput()
+  {
+#ifndef SCAFFOLD
+    std::cout.flush();
+#endif
+  }
+
+} // Namespace FixClient
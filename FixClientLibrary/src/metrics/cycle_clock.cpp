@@ -0,0 +1,48 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// cycle_clock.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <thread>
+
+#include "metrics/cycle_clock.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    double calibrate()
+    {
+      using Clock = std::chrono::steady_clock;
+
+      const Clock::time_point start = Clock::now();
+      const std::uint64_t startCycles = readCycles();
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+      const std::uint64_t cycles = readCycles() - startCycles;
+      const auto nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          Clock::now() - start
+        ).count();
+
+      return cycles > 0 ? static_cast<double>(nanoseconds) / cycles : 1.0;
+    }
+
+  }
+
+  double nanosecondsPerCycle()
+  {
+    static const double ratio = calibrate();
+    return ratio;
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,76 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// latency_histogram.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <cmath>
+
+#include "metrics/latency_histogram.hpp"
+
+namespace FixClient {
+
+  std::uint64_t LatencyHistogram::percentile(double fraction) const
+  {
+    // The counts of a live histogram may add up to more than count()
+    const std::uint64_t total = count();
+    if (total == 0) {
+      return 0;
+    }
+
+    const std::uint64_t rank = std::max<std::uint64_t>(
+      1,
+      static_cast<std::uint64_t>(std::ceil(fraction * total))
+    );
+
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+      seen += counts_[bucket].load(std::memory_order_relaxed);
+      if (seen >= rank) {
+        return std::min(highestOf(bucket), max());
+      }
+    }
+
+    return max();
+  }
+
+  void LatencyHistogram::merge(const LatencyHistogram& other)
+  {
+    for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+      counts_[bucket].fetch_add(
+        other.counts_[bucket].load(std::memory_order_relaxed),
+        std::memory_order_relaxed
+      );
+    }
+
+    count_.fetch_add(other.count(), std::memory_order_relaxed);
+
+    if (other.max() > max()) {
+      max_.store(other.max(), std::memory_order_relaxed);
+    }
+  }
+
+  std::uint64_t LatencyHistogram::highestOf(std::size_t bucket)
+  {
+    if (bucket < (std::size_t { 1 } << linearBits)) {
+      return bucket;
+    }
+
+    const unsigned shift =
+      static_cast<unsigned>(bucket >> (linearBits - 1)) - 1;
+    const std::uint64_t top =
+      bucket - (static_cast<std::size_t>(shift) << (linearBits - 1));
+
+    // Wraps to the largest value for the last bucket
+    return ((top + 1) << shift) - 1;
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,102 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// latency_metrics.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+
+#include "metrics/latency_metrics.hpp"
+
+namespace FixClient {
+
+  std::string_view toString(LatencyMessage message)
+  {
+    switch (message) {
+      case LatencyMessage::MarketDataSnapshot:
+        return "MarketDataSnapshot";
+
+      case LatencyMessage::MarketDataIncremental:
+        return "MarketDataIncremental";
+
+      case LatencyMessage::IOI:
+        return "IOI";
+
+      case LatencyMessage::ExecutionReport:
+        return "ExecutionReport";
+
+      case LatencyMessage::TradingSessionStatus:
+        return "TradingSessionStatus";
+
+      case LatencyMessage::SecurityList:
+        return "SecurityList";
+    }
+
+    return "Unknown";
+  }
+
+  std::string_view toString(LatencyStage stage)
+  {
+    switch (stage) {
+      case LatencyStage::Crack:
+        return "Crack";
+
+      case LatencyStage::Decode:
+        return "Decode";
+
+      case LatencyStage::Workflow:
+        return "Workflow";
+    }
+
+    return "Unknown";
+  }
+
+  LatencyMetrics::LatencyMetrics(std::size_t writers) :
+    writers_(std::max<std::size_t>(writers, 1)),
+    histograms_(std::make_unique<Histograms[]>(writers_))
+  {
+    // Nada
+  }
+
+  std::vector<LatencySummary> LatencyMetrics::summaries() const
+  {
+    const double scale = nanosecondsPerCycle();
+
+    std::vector<LatencySummary> result;
+
+    for (std::size_t message = 0; message < latencyMessageCount; ++message) {
+      for (std::size_t stage = 0; stage < latencyStageCount; ++stage) {
+        LatencyHistogram histogram;
+        for (std::size_t writer = 0; writer < writers_; ++writer) {
+          histogram.merge(
+            histograms_[writer][message * latencyStageCount + stage]
+          );
+        }
+
+        if (histogram.count() == 0) {
+          continue;
+        }
+
+        result.push_back(LatencySummary {
+          .message = static_cast<LatencyMessage>(message),
+          .stage = static_cast<LatencyStage>(stage),
+          .count = histogram.count(),
+          .p50 = histogram.percentile(0.5) * scale,
+          .p99 = histogram.percentile(0.99) * scale,
+          .p999 = histogram.percentile(0.999) * scale,
+          .max = histogram.max() * scale
+        });
+      }
+    }
+
+    return result;
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,420 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// compact_model.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include "model/compact_model.hpp"
+
+namespace FixClient {
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Enum Strings
+
+  std::string_view toString(AcknowledgeStatus value)
+  {
+    switch (value) {
+      case AcknowledgeStatus::NewOrderAccepted: return "NewOrderAccepted";
+      case AcknowledgeStatus::OrderCanceled: return "OrderCanceled";
+      case AcknowledgeStatus::OrderReplaced: return "OrderReplaced";
+    }
+    return "";
+  }
+
+  std::string_view toString(FillStatus value)
+  {
+    switch (value) {
+      case FillStatus::PartialFill: return "PartialFill";
+      case FillStatus::CompleteFill: return "CompleteFill";
+    }
+    return "";
+  }
+
+  std::string_view toString(PostTradeStatus value)
+  {
+    switch (value) {
+      case PostTradeStatus::Cancel: return "Cancel";
+      case PostTradeStatus::Correct: return "Correct";
+    }
+    return "";
+  }
+
+  std::string_view toString(TradeSide value)
+  {
+    switch (value) {
+      case TradeSide::Buy: return "Buy";
+      case TradeSide::Sell: return "Sell";
+    }
+    return "";
+  }
+
+  std::string_view toString(IOIAction value)
+  {
+    switch (value) {
+      case IOIAction::Create: return "Create";
+      case IOIAction::Update: return "Update";
+      case IOIAction::Delete: return "Delete";
+    }
+    return "";
+  }
+
+  std::string_view toString(IOISide value)
+  {
+    switch (value) {
+      case IOISide::Bid: return "Bid";
+      case IOISide::Offer: return "Offer";
+    }
+    return "";
+  }
+
+  std::string_view toString(IOIOwnership value)
+  {
+    switch (value) {
+      case IOIOwnership::NotMine: return "NotMine";
+      case IOIOwnership::IsMine: return "IsMine";
+      case IOIOwnership::MaybeMine: return "MaybeMine";
+    }
+    return "";
+  }
+
+  namespace {
+
+    // Reverse of toString. Falls back to the first candidate, so each
+    // list below starts with the value its codec defaults to
+    template <typename Enum, std::size_t Count>
+    Enum fromString(std::string_view value, const Enum (&values)[Count])
+    {
+      for (Enum candidate : values) {
+        if (toString(candidate) == value) {
+          return candidate;
+        }
+      }
+      return values[0];
+    }
+
+    constexpr AcknowledgeStatus acknowledgeStatuses[] = {
+      AcknowledgeStatus::NewOrderAccepted,
+      AcknowledgeStatus::OrderCanceled,
+      AcknowledgeStatus::OrderReplaced
+    };
+
+    constexpr FillStatus fillStatuses[] = {
+      FillStatus::PartialFill,
+      FillStatus::CompleteFill
+    };
+
+    constexpr PostTradeStatus postTradeStatuses[] = {
+      PostTradeStatus::Cancel,
+      PostTradeStatus::Correct
+    };
+
+    constexpr TradeSide tradeSides[] = {
+      TradeSide::Buy,
+      TradeSide::Sell
+    };
+
+    constexpr IOIAction ioiActions[] = {
+      IOIAction::Update,
+      IOIAction::Create,
+      IOIAction::Delete
+    };
+
+    constexpr IOISide ioiSides[] = {
+      IOISide::Offer,
+      IOISide::Bid
+    };
+
+    constexpr IOIOwnership ioiOwnerships[] = {
+      IOIOwnership::NotMine,
+      IOIOwnership::IsMine,
+      IOIOwnership::MaybeMine
+    };
+
+    template <typename String>
+    bool fits(std::string_view value)
+    {
+      return value.size() <= String::capacity();
+    }
+
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: To Compact
+
+  CompactMarketDataModel toCompact(const MarketDataModel& model)
+  {
+    return CompactMarketDataModel {
+      .quantity = model.quantity,
+      .price = model.price,
+      .yield = model.yield,
+      .securityId = model.securityId,
+      .securityCode = model.securityCode,
+      .action = model.action,
+      .entryType = model.entryType
+    };
+  }
+
+  CompactIOIOrderModel toCompact(const IOIOrderModel& model)
+  {
+    return CompactIOIOrderModel {
+      .quantity = model.quantity,
+      .price = model.price,
+      .yield = model.yield,
+      .securityId = model.securityId,
+      .ioiCode = model.ioiCode,
+      .securityCode = model.securityCode,
+      .action = fromString(model.action, ioiActions),
+      .bidOrOffer = fromString(model.bidOrOffer, ioiSides),
+      .isMine = fromString(model.isMine, ioiOwnerships)
+    };
+  }
+
+  CompactAcknowledgeEventModel toCompact(const AcknowledgeEventModel& model)
+  {
+    return CompactAcknowledgeEventModel {
+      .status = fromString(model.status, acknowledgeStatuses),
+      .reason = model.reason
+    };
+  }
+
+  CompactRejectEventModel toCompact(const RejectEventModel& model)
+  {
+    return CompactRejectEventModel {
+      .status = model.status,
+      .message = model.message
+    };
+  }
+
+  CompactFillEventModel toCompact(const FillEventModel& model)
+  {
+    return CompactFillEventModel {
+      .fillQuantity = model.fillQuantity,
+      .fillPrice = model.fillPrice,
+      .fillYield = model.fillYield,
+      .remainingQuantity = model.remainingQuantity,
+      .principal = model.principal,
+      .accrued = model.accrued,
+      .settlementAmount = model.settlementAmount,
+      .cumulativeQuantity = model.cumulativeQuantity,
+      .averagePrice = model.averagePrice,
+      .securityId = model.securityId,
+      .securityCode = model.securityCode,
+      .executionCode = model.executionCode,
+      .contraClearingMpid = model.contraClearingMpid,
+      .contraClearingAccount = model.contraClearingAccount,
+      .subscriberAccount = model.subscriberAccount,
+      .executedBy = model.executedBy,
+      .settlementDate = model.settlementDate,
+      .executedAt = model.executedAt,
+      .status = fromString(model.status, fillStatuses),
+      .side = fromString(model.side, tradeSides)
+    };
+  }
+
+  CompactPostTradeEventModel toCompact(const PostTradeEventModel& model)
+  {
+    return CompactPostTradeEventModel {
+      .status = fromString(model.status, postTradeStatuses),
+      .executionCode = model.executionCode,
+      .quantity = model.quantity,
+      .price = model.price,
+      .yield = model.yield,
+      .principal = model.principal,
+      .accrued = model.accrued,
+      .settlement = model.settlement
+    };
+  }
+
+  CompactExecutionEventModel toCompact(const ExecutionEventModel& model)
+  {
+    return CompactExecutionEventModel {
+      .orderCode = model.orderCode,
+      .value = std::visit(
+        [](const auto& payload) -> decltype(CompactExecutionEventModel::value)
+        {
+          return toCompact(payload);
+        },
+        model.value
+      )
+    };
+  }
+
+  CompactSecurityModel toCompact(const SecurityModel& model)
+  {
+    return CompactSecurityModel {
+      .code = model.code,
+      .kind = model.kind
+    };
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Fits Compact
+
+  bool fitsCompact(const MarketDataModel& model)
+  {
+    return fits<SecurityCodeString>(model.securityCode);
+  }
+
+  bool fitsCompact(const IOIOrderModel& model)
+  {
+    return fits<IOICodeString>(model.ioiCode)
+      && fits<SecurityCodeString>(model.securityCode);
+  }
+
+  bool fitsCompact([[ maybe_unused ]] const AcknowledgeEventModel& model)
+  {
+    return true;
+  }
+
+  bool fitsCompact([[ maybe_unused ]] const RejectEventModel& model)
+  {
+    return true;
+  }
+
+  bool fitsCompact(const FillEventModel& model)
+  {
+    return fits<SecurityCodeString>(model.securityCode)
+      && fits<ExecutionCodeString>(model.executionCode)
+      && fits<MpidString>(model.contraClearingMpid)
+      && fits<MpidString>(model.contraClearingAccount)
+      && fits<MpidString>(model.subscriberAccount)
+      && fits<MpidString>(model.executedBy)
+      && fits<TimestampString>(model.settlementDate)
+      && fits<TimestampString>(model.executedAt);
+  }
+
+  bool fitsCompact(const PostTradeEventModel& model)
+  {
+    return fits<ExecutionCodeString>(model.executionCode);
+  }
+
+  bool fitsCompact(const ExecutionEventModel& model)
+  {
+    return fits<OrderCodeString>(model.orderCode)
+      && std::visit([](const auto& payload) {
+        return fitsCompact(payload);
+      }, model.value);
+  }
+
+  bool fitsCompact(const SecurityModel& model)
+  {
+    return fits<SecurityCodeString>(model.code);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: To Model
+
+  MarketDataModel toModel(const CompactMarketDataModel& model)
+  {
+    return MarketDataModel {
+      .action = model.action,
+      .entryType = model.entryType,
+      .securityCode = model.securityCode.str(),
+      .securityId = model.securityId,
+      .quantity = model.quantity,
+      .price = model.price,
+      .yield = model.yield
+    };
+  }
+
+  IOIOrderModel toModel(const CompactIOIOrderModel& model)
+  {
+    return IOIOrderModel {
+      .ioiCode = model.ioiCode.str(),
+      .action = std::string(toString(model.action)),
+      .securityCode = model.securityCode.str(),
+      .securityId = model.securityId,
+      .bidOrOffer = std::string(toString(model.bidOrOffer)),
+      .quantity = model.quantity,
+      .price = model.price,
+      .yield = model.yield,
+      .isMine = std::string(toString(model.isMine))
+    };
+  }
+
+  AcknowledgeEventModel toModel(const CompactAcknowledgeEventModel& model)
+  {
+    return AcknowledgeEventModel {
+      .status = std::string(toString(model.status)),
+      .reason = model.reason.str()
+    };
+  }
+
+  RejectEventModel toModel(const CompactRejectEventModel& model)
+  {
+    return RejectEventModel {
+      .status = model.status,
+      .message = model.message.str()
+    };
+  }
+
+  FillEventModel toModel(const CompactFillEventModel& model)
+  {
+    return FillEventModel {
+      .status = std::string(toString(model.status)),
+      .securityCode = model.securityCode.str(),
+      .securityId = model.securityId,
+      .executionCode = model.executionCode.str(),
+      .contraClearingMpid = model.contraClearingMpid.str(),
+      .contraClearingAccount = model.contraClearingAccount.str(),
+      .subscriberAccount = model.subscriberAccount.str(),
+      .executedBy = model.executedBy.str(),
+      .side = std::string(toString(model.side)),
+      .fillQuantity = model.fillQuantity,
+      .fillPrice = model.fillPrice,
+      .fillYield = model.fillYield,
+      .remainingQuantity = model.remainingQuantity,
+      .principal = model.principal,
+      .accrued = model.accrued,
+      .settlementAmount = model.settlementAmount,
+      .settlementDate = model.settlementDate.str(),
+      .cumulativeQuantity = model.cumulativeQuantity,
+      .averagePrice = model.averagePrice,
+      .executedAt = model.executedAt.str()
+    };
+  }
+
+  PostTradeEventModel toModel(const CompactPostTradeEventModel& model)
+  {
+    return PostTradeEventModel {
+      .status = std::string(toString(model.status)),
+      .executionCode = model.executionCode.str(),
+      .quantity = model.quantity,
+      .price = model.price,
+      .yield = model.yield,
+      .principal = model.principal,
+      .accrued = model.accrued,
+      .settlement = model.settlement
+    };
+  }
+
+  ExecutionEventModel toModel(const CompactExecutionEventModel& model)
+  {
+    return ExecutionEventModel {
+      .orderCode = model.orderCode.str(),
+      .value = std::visit(
+        [](const auto& payload) -> decltype(ExecutionEventModel::value)
+        {
+          return toModel(payload);
+        },
+        model.value
+      )
+    };
+  }
+
+  SecurityModel toModel(const CompactSecurityModel& model)
+  {
+    return SecurityModel {
+      .code = model.code.str(),
+      .kind = model.kind
+    };
+  }
+
+} // Namespace FixClient
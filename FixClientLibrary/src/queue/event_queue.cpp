@@ -0,0 +1,222 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// event_queue.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <thread>
+
+#include "queue/event_queue.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    // Empty polls before the consumer parks
+    constexpr int spinLimit = 256;
+
+  }
+
+  EventQueue::EventQueue(std::size_t capacity, Backpressure backpressure) :
+    queue_(capacity),
+    backpressure_(backpressure)
+  {
+    // Nada
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Producer
+
+  void EventQueue::push(WorkflowEvent&& event)
+  {
+    if (std::holds_alternative<MarketDataEvent>(event)
+      && backpressure_ == Backpressure::Conflate
+    ) {
+      pushMarketData(event);
+    } else {
+      pushEvent(event, backpressure_ == Backpressure::DropOldest
+        && ( std::holds_alternative<MarketDataEvent>(event)
+          || std::holds_alternative<IOIOrderModel>(event)
+        )
+      );
+    }
+
+    recordDepth();
+    wake();
+  }
+
+  void EventQueue::pushEvent(WorkflowEvent& event, bool discardable)
+  {
+    while (!queue_.tryPush(event, discardable)) {
+      if (backpressure_ == Backpressure::DropOldest
+        && queue_.discardOldest()
+      ) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      wake();
+      std::this_thread::yield();
+    }
+  }
+
+  void EventQueue::pushMarketData(WorkflowEvent& event)
+  {
+    MarketDataEvent& marketData = std::get<MarketDataEvent>(event);
+
+    if (marketData.snapshot) {
+      // Entries conflated before the snapshot go ahead of it. A marker
+      // still queued is now stale, entries conflated after the
+      // snapshot need a new one behind it.
+      WorkflowEvent older { MarketDataEvent {} };
+      if (conflator_.flush(std::get<MarketDataEvent>(older).data)) {
+        pushEvent(older, false);
+      }
+      conflatedQueued_.store(false, std::memory_order_relaxed);
+      pushEvent(event, false);
+      return;
+    }
+
+    conflator_.add(marketData.data);
+
+    // Cleared by the consumer before it takes the entries
+    if (!conflator_.empty()
+      && !conflatedQueued_.load(std::memory_order_acquire)
+    ) {
+      WorkflowEvent signal { ConflatedMarker {
+        .generation = conflator_.generation()
+      } };
+      conflatedQueued_.store(true, std::memory_order_relaxed);
+      if (!queue_.tryPush(signal)) {
+        conflatedQueued_.store(false, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void EventQueue::recordDepth()
+  {
+    const std::size_t depth = queue_.size();
+    if (depth > highWater_.load(std::memory_order_relaxed)) {
+      highWater_.store(depth, std::memory_order_relaxed);
+    }
+  }
+
+  void EventQueue::wake()
+  {
+    // Pairs with the fence in pop(), either we see the consumer parked
+    // or it sees our event
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (waiting_.load(std::memory_order_relaxed)) {
+      signal_.fetch_add(1, std::memory_order_release);
+      signal_.notify_one();
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Consumer
+
+  bool EventQueue::pop(WorkflowEvent& event)
+  {
+    int spins = 0;
+
+    for (;;) {
+      if (queue_.tryPop(event)) {
+        if (!std::holds_alternative<ConflatedMarker>(event)) {
+          return true;
+        }
+
+        // A stale marker sits ahead of the snapshot that flushed its
+        // entries, the ones conflated since belong behind it
+        const std::uint64_t generation =
+          std::get<ConflatedMarker>(event).generation;
+        if (generation != conflator_.generation()) {
+          continue;
+        }
+
+        conflatedQueued_.store(false, std::memory_order_release);
+        if (takeConflated(event, &generation)) {
+          return true;
+        }
+        continue;
+      }
+
+      // The conflator had no room for its marker
+      if (!conflator_.empty() && takeConflated(event, nullptr)) {
+        return true;
+      }
+
+      // Events pushed before stop() are visible from here on
+      if (stopped_.load(std::memory_order_acquire)) {
+        if (queue_.empty() && conflator_.empty()) {
+          return false;
+        }
+        continue;
+      }
+
+      if (++spins < spinLimit) {
+        continue;
+      }
+
+      waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      const std::uint32_t signal = signal_.load(std::memory_order_acquire);
+      if (!hasWork()) {
+        signal_.wait(signal, std::memory_order_acquire);
+      }
+
+      waiting_.store(false, std::memory_order_relaxed);
+      spins = 0;
+    }
+  }
+
+  bool EventQueue::takeConflated(WorkflowEvent& event,
+    const std::uint64_t* generation)
+  {
+    if (!std::holds_alternative<MarketDataEvent>(event)) {
+      event = MarketDataEvent {};
+    }
+
+    MarketDataEvent& marketData = std::get<MarketDataEvent>(event);
+    marketData.snapshot = false;
+    return generation
+      ? conflator_.take(marketData.data, *generation)
+      : conflator_.take(marketData.data);
+  }
+
+  bool EventQueue::hasWork() const
+  {
+    return !queue_.empty()
+      || !conflator_.empty()
+      || stopped_.load(std::memory_order_acquire);
+  }
+
+  void EventQueue::stop()
+  {
+    stopped_.store(true, std::memory_order_release);
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_one();
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Stats
+
+  EventQueueStats EventQueue::stats() const
+  {
+    return EventQueueStats {
+      .depth = queue_.size(),
+      .highWater = highWater_.load(std::memory_order_relaxed),
+      .dropped = dropped_.load(std::memory_order_relaxed),
+      .conflated = conflator_.collapsed()
+    };
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,118 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// market_data_conflator.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include "queue/market_data_conflator.hpp"
+#include "state/top_of_book.hpp"
+
+namespace FixClient {
+
+  bool MarketDataConflator::add(const std::vector<MarketDataModel>& data)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const bool wasClean = order_.empty();
+
+    for (const MarketDataModel& model : data) {
+      std::optional<TopOfBookEntry> entry = toTopOfBookEntry(model.entryType);
+
+      if (model.securityId == noSecurityId || !entry.has_value()) {
+        order_.push_back(unkeyed);
+        unkeyed_.push_back(model);
+        continue;
+      }
+
+      const std::size_t slot = model.securityId * topOfBookEntryCount
+        + static_cast<std::size_t>(entry.value());
+
+      if (slot >= slots_.size()) {
+        slots_.resize(slot + 1);
+        isDirty_.resize(slot + 1, 0);
+      }
+
+      // Reuses the slot's string, no allocation for ISINs and CUSIPs
+      slots_[slot] = model;
+
+      if (isDirty_[slot]) {
+        collapsed_.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        isDirty_[slot] = 1;
+        order_.push_back(static_cast<std::uint32_t>(slot));
+      }
+    }
+
+    dirty_.store(!order_.empty(), std::memory_order_release);
+    return wasClean && !order_.empty();
+  }
+
+  bool MarketDataConflator::take(std::vector<MarketDataModel>& out)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return takeLocked(out);
+  }
+
+  bool MarketDataConflator::take(std::vector<MarketDataModel>& out,
+    std::uint64_t generation)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (generation != generation_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    return takeLocked(out);
+  }
+
+  bool MarketDataConflator::flush(std::vector<MarketDataModel>& out)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    generation_.fetch_add(1, std::memory_order_release);
+    return takeLocked(out);
+  }
+
+  bool MarketDataConflator::takeLocked(std::vector<MarketDataModel>& out)
+  {
+    if (order_.empty()) {
+      return false;
+    }
+
+    out.resize(order_.size());
+
+    std::size_t next = 0;
+    std::size_t nextUnkeyed = 0;
+    for (std::uint32_t slot : order_) {
+      if (slot == unkeyed) {
+        out[next++] = std::move(unkeyed_[nextUnkeyed++]);
+      } else {
+        out[next++] = slots_[slot];
+        isDirty_[slot] = 0;
+      }
+    }
+
+    order_.clear();
+    unkeyed_.clear();
+    dirty_.store(false, std::memory_order_release);
+    return true;
+  }
+
+  void MarketDataConflator::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    slots_.clear();
+    isDirty_.clear();
+    order_.clear();
+    unkeyed_.clear();
+    dirty_.store(false, std::memory_order_release);
+  }
+
+} // Namespace FixClient
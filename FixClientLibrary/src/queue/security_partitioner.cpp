@@ -0,0 +1,49 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// security_partitioner.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include "queue/security_partitioner.hpp"
+
+namespace FixClient {
+
+  SecurityPartitioner::SecurityPartitioner(std::size_t workers) :
+    workers_(workers > 0
+      ? workers
+      : std::max<std::size_t>(std::thread::hardware_concurrency(), 1))
+  {
+    // Nada
+  }
+
+  std::size_t SecurityPartitioner::workerOf(SecurityId securityId,
+    std::string_view securityCode) const
+  {
+    if (securityId != noSecurityId) {
+      return securityId % workers_;
+    }
+    return std::hash<std::string_view>{}(securityCode) % workers_;
+  }
+
+  void SecurityPartitioner::split(const std::vector<MarketDataModel>& data,
+    std::vector<std::vector<MarketDataModel>>& parts) const
+  {
+    parts.resize(workers_);
+
+    for (const MarketDataModel& model : data) {
+      parts[workerOf(model.securityId, model.securityCode)].push_back(model);
+    }
+  }
+
+} // Namespace FixClient
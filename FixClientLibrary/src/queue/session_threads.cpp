@@ -0,0 +1,86 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// session_threads.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <cstring>
+
+#include "log.hpp"
+#include "queue/session_threads.hpp"
+
+namespace FixClient {
+
+  SessionRole sessionRoleOf(std::string_view compId)
+  {
+    if (compId.ends_with("-MD")) {
+      return SessionRole::MarketData;
+    }
+    if (compId.ends_with("-OB")) {
+      return SessionRole::OrderBook;
+    }
+    return SessionRole::Trading;
+  }
+
+  const char* toString(SessionRole role)
+  {
+    switch (role) {
+      case SessionRole::MarketData:
+        return "MD";
+
+      case SessionRole::OrderBook:
+        return "OB";
+
+      case SessionRole::Trading:
+        return "TR";
+    }
+    return "Unknown";
+  }
+
+  void configureSessionThread(SessionRole role,
+    const SessionThreadOptions& options)
+  {
+    Log log;
+
+    if (options.cpu >= 0) {
+#if defined(__linux__)
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(options.cpu, &cpus);
+
+      const int error =
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+      if (error != 0) {
+        log.logWarning("[{}] Could not pin to CPU {}: {}",
+          toString(role), options.cpu, std::strerror(error));
+      }
+#else
+      log.logWarning("[{}] Pinning threads is not supported here",
+        toString(role));
+#endif
+    }
+
+    if (options.realtimePriority > 0) {
+      sched_param parameters {};
+      parameters.sched_priority = options.realtimePriority;
+
+      const int error =
+        pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+      if (error != 0) {
+        log.logWarning("[{}] Could not set SCHED_FIFO priority {}: {}",
+          toString(role), options.realtimePriority, std::strerror(error));
+      }
+    }
+  }
+
+} // Namespace FixClient
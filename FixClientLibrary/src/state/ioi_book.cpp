@@ -0,0 +1,357 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// ioi_book.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+
+#include "state/ioi_book.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    constexpr std::size_t initialIndexSize = 1024;
+
+    // Bids sort high to low, offers low to high
+    bool isBetter(IOISide side, double lhs, double rhs)
+    {
+      return side == IOISide::Bid ? lhs > rhs : lhs < rhs;
+    }
+
+    std::vector<IOIBookLevel>& levelsOf(IOISecurityBook& book, IOISide side)
+    {
+      return side == IOISide::Bid ? book.bids : book.offers;
+    }
+
+  }
+
+  IOIBook::IOIBook(SecurityTable& securities) :
+    index_(initialIndexSize, none),
+    securities_(securities)
+  {
+    // Nada
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Apply
+
+  bool IOIBook::apply(const IOIOrderModel& model)
+  {
+    if (!fitsCompact(model)) {
+      if (oversizeLimiter_.allow()) {
+        log_.logWarning("IOI {} of {} has a code too long, ignored",
+          model.ioiCode, model.securityCode);
+      }
+      return false;
+    }
+
+    return apply(toCompact(model));
+  }
+
+  bool IOIBook::apply(const CompactIOIOrderModel& model)
+  {
+    const std::string_view ioiCode = model.ioiCode.view();
+    const std::uint32_t hash = hashOf(ioiCode);
+    const std::size_t slot = findSlot(ioiCode, hash);
+    const bool known = index_[slot] != none;
+
+    if (model.action == IOIAction::Delete) {
+      if (!known) {
+        return false;
+      }
+
+      const std::uint32_t order = index_[slot];
+      removeFromLevel(orders_[order]);
+      eraseIndex(slot);
+      freeOrder(order);
+      return true;
+    }
+
+    const IOIBookOrder updated {
+      .ioiCode = model.ioiCode,
+      .quantity = model.quantity,
+      .price = model.price,
+      .yield = model.yield,
+      .security = securityFor(model),
+      .hash = hash,
+      .nextFree = none,
+      .side = model.bidOrOffer,
+      .ownership = model.isMine
+    };
+
+    // Create or Update
+    std::uint32_t order;
+    if (known) {
+      order = index_[slot];
+
+      // Resent as it rests, the book stays as it is
+      const IOIBookOrder& resting = orders_[order];
+      if ( resting.quantity == updated.quantity
+        && resting.price == updated.price
+        && resting.yield == updated.yield
+        && resting.security == updated.security
+        && resting.side == updated.side
+        && resting.ownership == updated.ownership
+      ) {
+        return false;
+      }
+
+      removeFromLevel(resting);
+    } else {
+      order = allocateOrder();
+    }
+
+    IOIBookOrder& entry = orders_[order];
+    entry = updated;
+
+    addToLevel(entry);
+
+    if (!known) {
+      insertIndex(order);
+    }
+
+    return true;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Queries
+
+  const IOISecurityBook* IOIBook::find(SecurityId securityId) const
+  {
+    if (securityId >= books_.size() || !active_[securityId]) {
+      return nullptr;
+    }
+    return &books_[securityId];
+  }
+
+  const IOISecurityBook* IOIBook::find(std::string_view securityCode) const
+  {
+    return find(securities_.find(securityCode));
+  }
+
+  const IOIBookOrder* IOIBook::findOrder(std::string_view ioiCode) const
+  {
+    const std::size_t slot = findSlot(ioiCode, hashOf(ioiCode));
+    if (index_[slot] == none) {
+      return nullptr;
+    }
+    return &orders_[index_[slot]];
+  }
+
+  void IOIBook::reserve(std::size_t orders, std::size_t securities,
+    std::size_t levels)
+  {
+    orders_.reserve(orders);
+    while (index_.size() < orders * 2) {
+      growIndex();
+    }
+
+    if (securities > books_.size()) {
+      books_.resize(securities);
+      active_.resize(securities, 0);
+    }
+
+    for (IOISecurityBook& book : books_) {
+      book.bids.reserve(levels);
+      book.offers.reserve(levels);
+    }
+  }
+
+  void IOIBook::clear()
+  {
+    orders_.clear();
+    freeList_ = none;
+    orderCount_ = 0;
+    std::fill(index_.begin(), index_.end(), none);
+
+    for (IOISecurityBook& book : books_) {
+      book.bids.clear();
+      book.offers.clear();
+    }
+    std::fill(active_.begin(), active_.end(), 0);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Securities
+
+  SecurityId IOIBook::securityFor(const CompactIOIOrderModel& model)
+  {
+    const SecurityId security = model.securityId != noSecurityId
+      ? model.securityId
+      : securities_.intern(model.securityCode.view());
+
+    if (security >= books_.size()) {
+      books_.resize(security + 1);
+      active_.resize(security + 1, 0);
+    }
+    active_[security] = 1;
+
+    return security;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Order Pool
+
+  std::uint32_t IOIBook::allocateOrder()
+  {
+    ++orderCount_;
+
+    if (freeList_ != none) {
+      const std::uint32_t order = freeList_;
+      freeList_ = orders_[order].nextFree;
+      return order;
+    }
+
+    orders_.emplace_back();
+    return static_cast<std::uint32_t>(orders_.size() - 1);
+  }
+
+  void IOIBook::freeOrder(std::uint32_t order)
+  {
+    --orderCount_;
+
+    orders_[order].nextFree = freeList_;
+    freeList_ = order;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: IOI Code Index
+
+  std::uint32_t IOIBook::hashOf(std::string_view ioiCode)
+  {
+    return static_cast<std::uint32_t>(
+      std::hash<std::string_view>{}(ioiCode)
+    );
+  }
+
+  // The slot holding the code, or the empty slot it would go in
+  std::size_t IOIBook::findSlot(std::string_view ioiCode,
+    std::uint32_t hash) const
+  {
+    const std::size_t mask = index_.size() - 1;
+    std::size_t slot = hash & mask;
+
+    while (index_[slot] != none) {
+      const IOIBookOrder& order = orders_[index_[slot]];
+      if (order.hash == hash && order.ioiCode.view() == ioiCode) {
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+
+    return slot;
+  }
+
+  void IOIBook::insertIndex(std::uint32_t order)
+  {
+    // Keep the load at one half at most
+    if (orderCount_ * 2 > index_.size()) {
+      growIndex();
+    }
+
+    const IOIBookOrder& entry = orders_[order];
+    index_[findSlot(entry.ioiCode.view(), entry.hash)] = order;
+  }
+
+  // Backward shift deletion, so lookups never need tombstones
+  void IOIBook::eraseIndex(std::size_t slot)
+  {
+    const std::size_t mask = index_.size() - 1;
+    std::size_t hole = slot;
+    std::size_t next = (hole + 1) & mask;
+
+    while (index_[next] != none) {
+      const std::size_t home = orders_[index_[next]].hash & mask;
+
+      // Move the entry back unless its home lies after the hole
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        index_[hole] = index_[next];
+        hole = next;
+      }
+      next = (next + 1) & mask;
+    }
+
+    index_[hole] = none;
+  }
+
+  void IOIBook::growIndex()
+  {
+    std::vector<std::uint32_t> previous(index_.size() * 2, none);
+    previous.swap(index_);
+
+    for (std::uint32_t order : previous) {
+      if (order != none) {
+        const IOIBookOrder& entry = orders_[order];
+        index_[findSlot(entry.ioiCode.view(), entry.hash)] = order;
+      }
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Price Levels
+
+  void IOIBook::addToLevel(const IOIBookOrder& order)
+  {
+    std::vector<IOIBookLevel>& levels =
+      levelsOf(books_[order.security], order.side);
+
+    auto level = std::lower_bound(levels.begin(), levels.end(), order.price,
+      [&](const IOIBookLevel& candidate, double price) {
+        return isBetter(order.side, candidate.price, price);
+      }
+    );
+
+    if (level == levels.end() || level->price != order.price) {
+      level = levels.insert(level, IOIBookLevel {
+        .price = order.price,
+        .yield = order.yield,
+        .quantity = 0.0,
+        .orders = 0,
+        .mine = 0,
+        .maybeMine = 0
+      });
+    }
+
+    level->quantity += order.quantity;
+    level->orders += 1;
+    level->mine += order.ownership == IOIOwnership::IsMine;
+    level->maybeMine += order.ownership == IOIOwnership::MaybeMine;
+  }
+
+  void IOIBook::removeFromLevel(const IOIBookOrder& order)
+  {
+    std::vector<IOIBookLevel>& levels =
+      levelsOf(books_[order.security], order.side);
+
+    auto level = std::lower_bound(levels.begin(), levels.end(), order.price,
+      [&](const IOIBookLevel& candidate, double price) {
+        return isBetter(order.side, candidate.price, price);
+      }
+    );
+
+    if (level == levels.end() || level->price != order.price) {
+      return;
+    }
+
+    level->orders -= 1;
+    level->mine -= order.ownership == IOIOwnership::IsMine;
+    level->maybeMine -= order.ownership == IOIOwnership::MaybeMine;
+
+    // Drop empty levels, rather than keep a quantity rounding residue
+    if (level->orders == 0) {
+      levels.erase(level);
+    } else {
+      level->quantity -= order.quantity;
+    }
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,534 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// order_cache.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+#include "state/order_cache.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    // Key and fill slots per order. Replaces and fills add keys, and
+    // the tables stop taking them at three quarters full.
+    constexpr std::size_t slotsPerOrder = 4;
+
+    std::size_t slotsFor(std::size_t capacity)
+    {
+      return std::bit_ceil(
+        std::max<std::size_t>(capacity * slotsPerOrder, 2)
+      );
+    }
+
+    bool isFull(std::size_t count, std::size_t mask)
+    {
+      return (count + 1) * 4 > (mask + 1) * 3;
+    }
+
+    OrderRecord pendingNew(const OrderModel& model)
+    {
+      OrderRecord record;
+      record.orderCode = model.orderCode;
+      record.securityCode = model.security.code;
+      record.state = OrderState::PendingNew;
+      record.side = model.side;
+      record.kind = model.kind;
+      record.quantity = model.quantity;
+      record.price = model.price;
+      record.leavesQuantity = model.quantity;
+      return record;
+    }
+
+    // See ExposureChange::tracked
+    ExposureChange untracked()
+    {
+      ExposureChange change;
+      change.tracked = false;
+      return change;
+    }
+
+    void clearPending(OrderRecord& record)
+    {
+      record.pendingOrderCode = OrderCodeString();
+      record.pendingQuantity = 0.0;
+      record.pendingPrice = 0.0;
+    }
+
+  }
+
+  std::string_view toString(OrderState value)
+  {
+    switch (value) {
+      case OrderState::PendingNew: return "PendingNew";
+      case OrderState::Live: return "Live";
+      case OrderState::PendingReplace: return "PendingReplace";
+      case OrderState::PendingCancel: return "PendingCancel";
+      case OrderState::Filled: return "Filled";
+      case OrderState::Canceled: return "Canceled";
+      case OrderState::Rejected: return "Rejected";
+    }
+    return "";
+  }
+
+  double exposureOf(const OrderRecord& record)
+  {
+    if (isFinal(record.state)) {
+      return 0.0;
+    }
+
+    const double working =
+      notionalOf(record.kind, record.leavesQuantity, record.price);
+
+    if (record.state != OrderState::PendingReplace) {
+      return working;
+    }
+
+    // Until its ack either the order or the replace may fill
+    const double replacing = notionalOf(record.kind,
+      std::max(record.pendingQuantity - record.cumulativeQuantity, 0.0),
+      record.pendingPrice);
+
+    return std::max(working, replacing);
+  }
+
+  OrderCache::OrderCache(std::size_t capacity) :
+    records_(std::make_unique<SeqLocked<OrderRecord>[]>(capacity)),
+    capacity_(capacity),
+    shadow_(capacity),
+    notional_(capacity, 0.0),
+    keys_(std::make_unique<KeySlot[]>(slotsFor(capacity))),
+    keyMask_(slotsFor(capacity) - 1),
+    fills_(slotsFor(capacity)),
+    fillMask_(fills_.size() - 1)
+  {
+    // Nada
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Writers
+
+  ExposureChange OrderCache::onOrderSent(const OrderModel& model)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (model.action == OrderAction::New) {
+      const std::uint32_t known = recordOf(model.orderCode);
+
+      // Sent again after the first send failed, as if it were new
+      if (known != noRecord) {
+        if (!recordAt(known).notSent) {
+          return {};
+        }
+
+        recordAt(known) = pendingNew(model);
+        notional_[known - 1] = 0.0;
+        publish(known);
+        return changeOf(known, 0.0);
+      }
+
+      const OrderRecord record = pendingNew(model);
+      const std::uint32_t index = addRecord(model.orderCode, record);
+      return index == noRecord ? untracked() : changeOf(index, 0.0);
+    }
+
+    const std::uint32_t index = recordOf(model.originalOrderCode);
+    if (index == noRecord) {
+      return untracked();
+    }
+
+    if ( recordOf(model.orderCode) != index
+      && !addKey(model.orderCode, index)
+    ) {
+      return untracked();
+    }
+
+    OrderRecord& record = recordAt(index);
+    const double before = exposureOf(record);
+    record.pendingOrderCode = model.orderCode;
+
+    // The venue rejects changes to final orders, the reject then only
+    // clears the pending code
+    if (!isFinal(record.state)) {
+      if (model.action == OrderAction::Replace) {
+        record.state = OrderState::PendingReplace;
+        record.pendingQuantity = model.quantity;
+        record.pendingPrice = model.price;
+      } else {
+        record.state = OrderState::PendingCancel;
+      }
+    }
+
+    publish(index);
+    return changeOf(index, before);
+  }
+
+  ExposureChange OrderCache::onSendFailed(const OrderModel& model)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const std::uint32_t index = recordOf(model.orderCode);
+    if (index == noRecord) {
+      return {};
+    }
+
+    OrderRecord& record = recordAt(index);
+    const double before = exposureOf(record);
+    const bool wasNew = record.state == OrderState::PendingNew
+      && record.orderCode.view() == model.orderCode;
+
+    reject(index, model.orderCode, 0);
+
+    if (wasNew) {
+      record.notSent = true;
+    }
+
+    publish(index);
+    return changeOf(index, before);
+  }
+
+  ExposureChange OrderCache::apply(const ExecutionEventModel& event)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Found by execution code, which outlives replaces
+    if (const auto* model = std::get_if<PostTradeEventModel>(&event.value)) {
+      return postTrade(*model);
+    }
+
+    const std::uint32_t index = recordOf(event.orderCode);
+    if (index == noRecord) {
+      return {};
+    }
+
+    const double before = exposureOf(recordAt(index));
+
+    if (const auto* model = std::get_if<AcknowledgeEventModel>(&event.value)) {
+      acknowledge(index, event.orderCode, *model);
+    }
+
+    if (const auto* model = std::get_if<RejectEventModel>(&event.value)) {
+      reject(index, event.orderCode, model->status);
+    }
+
+    if (const auto* model = std::get_if<FillEventModel>(&event.value)) {
+      fill(index, *model);
+    }
+
+    publish(index);
+    return changeOf(index, before);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Readers
+
+  bool OrderCache::find(std::string_view orderCode,
+    OrderRecord& record) const
+  {
+    const std::uint32_t index = recordOf(orderCode);
+    if (index == noRecord) {
+      return false;
+    }
+
+    records_[index - 1].load(record);
+    return true;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Transitions
+
+  void OrderCache::reject(std::uint32_t index, std::string_view orderCode,
+    int reason)
+  {
+    OrderRecord& record = recordAt(index);
+    record.rejectReason = reason;
+
+    // A replace or cancel, the order keeps working as it was
+    if ( !record.pendingOrderCode.empty()
+      && record.pendingOrderCode == orderCode
+    ) {
+      clearPending(record);
+
+      if (!isFinal(record.state)) {
+        record.state = OrderState::Live;
+      }
+      return;
+    }
+
+    if (record.state == OrderState::PendingNew) {
+      record.state = OrderState::Rejected;
+      settle(index);
+    }
+  }
+
+  void OrderCache::acknowledge(std::uint32_t index,
+    std::string_view orderCode, const AcknowledgeEventModel& model)
+  {
+    OrderRecord& record = recordAt(index);
+
+    if (model.status == "NewOrderAccepted") {
+      // A replace or cancel may already be on its way
+      if (record.state == OrderState::PendingNew) {
+        record.state = OrderState::Live;
+      }
+      return;
+    }
+
+    if (model.status == "OrderReplaced") {
+      if (record.pendingOrderCode == orderCode) {
+        record.quantity = record.pendingQuantity;
+        record.price = record.pendingPrice;
+      }
+
+      record.orderCode = orderCode;
+      clearPending(record);
+
+      if (!isFinal(record.state)) {
+        record.state = OrderState::Live;
+      }
+
+      // Replaced down to what already filled
+      if (record.cumulativeQuantity >= record.quantity) {
+        record.state = OrderState::Filled;
+      }
+
+      settle(index);
+      return;
+    }
+
+    if (model.status == "OrderCanceled") {
+      clearPending(record);
+      record.state = OrderState::Canceled;
+      settle(index);
+    }
+  }
+
+  void OrderCache::fill(std::uint32_t index, const FillEventModel& model)
+  {
+    // Resent after a reconnect
+    if (findFill(model.executionCode) != nullptr) {
+      return;
+    }
+
+    OrderRecord& record = recordAt(index);
+
+    record.fills += 1;
+    record.cumulativeQuantity += model.fillQuantity;
+    notional_[index - 1] += model.fillQuantity * model.fillPrice;
+
+    if ( model.status == "CompleteFill"
+      || record.cumulativeQuantity >= record.quantity
+    ) {
+      record.state = OrderState::Filled;
+      clearPending(record);
+    }
+
+    settle(index);
+
+    if (FillSlot* slot = addFill(model.executionCode)) {
+      slot->record = index;
+      slot->quantity = model.fillQuantity;
+      slot->price = model.fillPrice;
+    }
+  }
+
+  // Final orders stay final, a busted fill does not put them back to
+  // work on the venue
+  ExposureChange OrderCache::postTrade(const PostTradeEventModel& model)
+  {
+    FillSlot* slot = findFill(model.executionCode);
+    if (slot == nullptr) {
+      return {};
+    }
+
+    const bool isCancel = model.status == "Cancel";
+    const double quantity = isCancel ? 0.0 : model.quantity;
+    const double price = isCancel ? 0.0 : model.price;
+
+    OrderRecord& record = recordAt(slot->record);
+    const double before = exposureOf(record);
+    record.cumulativeQuantity += quantity - slot->quantity;
+    notional_[slot->record - 1] +=
+      quantity * price - slot->quantity * slot->price;
+
+    slot->quantity = quantity;
+    slot->price = price;
+
+    settle(slot->record);
+    publish(slot->record);
+    return changeOf(slot->record, before);
+  }
+
+  ExposureChange OrderCache::changeOf(std::uint32_t index, double before)
+  {
+    const OrderRecord& record = recordAt(index);
+    return { record.securityCode, exposureOf(record) - before };
+  }
+
+  void OrderCache::settle(std::uint32_t index)
+  {
+    OrderRecord& record = recordAt(index);
+
+    record.leavesQuantity = isFinal(record.state)
+      ? 0.0
+      : std::max(record.quantity - record.cumulativeQuantity, 0.0);
+
+    record.averagePrice = record.cumulativeQuantity > 0.0
+      ? notional_[index - 1] / record.cumulativeQuantity
+      : 0.0;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Tables
+
+  std::size_t OrderCache::hashOf(std::string_view code)
+  {
+    return std::hash<std::string_view>{}(code);
+  }
+
+  // Readers probe concurrently with addKey. A slot's code is written
+  // before its record is published and never changes after.
+  std::uint32_t OrderCache::recordOf(std::string_view orderCode) const
+  {
+    // Never added, see addKey
+    if (orderCode.size() > OrderCodeString::capacity()) {
+      return noRecord;
+    }
+
+    std::size_t slot = hashOf(orderCode) & keyMask_;
+
+    for (;;) {
+      const std::uint32_t record =
+        keys_[slot].record.load(std::memory_order_acquire);
+
+      if (record == noRecord) {
+        return noRecord;
+      }
+      if (keys_[slot].orderCode == orderCode) {
+        return record;
+      }
+      slot = (slot + 1) & keyMask_;
+    }
+  }
+
+  // A truncated code could stand for two orders, a code that does not
+  // fit is not tracked at all
+  bool OrderCache::addKey(std::string_view orderCode, std::uint32_t record)
+  {
+    if (orderCode.size() > OrderCodeString::capacity()) {
+      if (oversizeLimiter_.allow()) {
+        log_.logWarning("ClOrdID {} is longer than {}, not tracked",
+          orderCode, OrderCodeString::capacity());
+      }
+      return false;
+    }
+
+    if (isFull(keyCount_, keyMask_)) {
+      if (fullLimiter_.allow()) {
+        log_.logWarning("Order cache keys full, {} not tracked", orderCode);
+      }
+      return false;
+    }
+
+    std::size_t slot = hashOf(orderCode) & keyMask_;
+    while (keys_[slot].record.load(std::memory_order_relaxed) != noRecord) {
+      slot = (slot + 1) & keyMask_;
+    }
+
+    keys_[slot].orderCode = orderCode;
+    keys_[slot].record.store(record, std::memory_order_release);
+    ++keyCount_;
+    return true;
+  }
+
+  std::uint32_t OrderCache::addRecord(std::string_view orderCode,
+    const OrderRecord& record)
+  {
+    const std::size_t size = size_.load(std::memory_order_relaxed);
+
+    if (size == capacity_) {
+      if (fullLimiter_.allow()) {
+        log_.logWarning("Order cache full, {} not tracked", orderCode);
+      }
+      return noRecord;
+    }
+
+    const auto index = static_cast<std::uint32_t>(size + 1);
+    shadow_[size] = record;
+    notional_[size] = 0.0;
+
+    // Readers can only reach the record through its key, so it must
+    // be complete before the key is
+    publish(index);
+    if (!addKey(orderCode, index)) {
+      return noRecord;
+    }
+
+    size_.store(size + 1, std::memory_order_release);
+    return index;
+  }
+
+  OrderCache::FillSlot* OrderCache::findFill(std::string_view executionCode)
+  {
+    // Never added, see addFill
+    if (executionCode.size() > ExecutionCodeString::capacity()) {
+      return nullptr;
+    }
+
+    std::size_t slot = hashOf(executionCode) & fillMask_;
+
+    while (fills_[slot].record != noRecord) {
+      if (fills_[slot].executionCode == executionCode) {
+        return &fills_[slot];
+      }
+      slot = (slot + 1) & fillMask_;
+    }
+
+    return nullptr;
+  }
+
+  OrderCache::FillSlot* OrderCache::addFill(std::string_view executionCode)
+  {
+    if (FillSlot* slot = findFill(executionCode)) {
+      return slot;
+    }
+
+    if (executionCode.size() > ExecutionCodeString::capacity()) {
+      if (oversizeLimiter_.allow()) {
+        log_.logWarning("ExecID {} is longer than {}, cannot be busted",
+          executionCode, ExecutionCodeString::capacity());
+      }
+      return nullptr;
+    }
+
+    if (isFull(fillCount_, fillMask_)) {
+      if (fullLimiter_.allow()) {
+        log_.logWarning(
+          "Order cache fills full, {} cannot be busted", executionCode
+        );
+      }
+      return nullptr;
+    }
+
+    std::size_t slot = hashOf(executionCode) & fillMask_;
+    while (fills_[slot].record != noRecord) {
+      slot = (slot + 1) & fillMask_;
+    }
+
+    fills_[slot].executionCode = executionCode;
+    ++fillCount_;
+    return &fills_[slot];
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,353 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// position_book.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+
+#include "state/position_book.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    // A third more than the entries, so probes stay short
+    std::size_t slotsFor(std::size_t capacity)
+    {
+      return std::bit_ceil(capacity + capacity / 3 + 1);
+    }
+
+  }
+
+  PositionBook::PositionBook(std::size_t positionCapacity,
+    std::size_t fillCapacity) :
+    capacity_(positionCapacity),
+    shadow_(positionCapacity),
+    positions_(
+      std::make_unique<SeqLocked<PositionModel>[]>(positionCapacity)
+    ),
+    keys_(std::make_unique<PositionSlot[]>(slotsFor(positionCapacity))),
+    keyMask_(slotsFor(positionCapacity) - 1),
+    fills_(slotsFor(fillCapacity)),
+    fillMask_(fills_.size() - 1),
+    fillCapacity_(fillCapacity),
+    fillOrder_(fillCapacity)
+  {
+    // Nada
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Writer
+
+  void PositionBook::apply(const ExecutionEventModel& event)
+  {
+    if (const auto* model = std::get_if<FillEventModel>(&event.value)) {
+      fill(*model);
+      return;
+    }
+
+    if (const auto* model = std::get_if<PostTradeEventModel>(&event.value)) {
+      postTrade(*model);
+    }
+  }
+
+  void PositionBook::fill(const FillEventModel& model)
+  {
+    // Resent after a reconnect
+    if (findFill(model.executionCode) != nullptr) {
+      return;
+    }
+
+    std::uint32_t position =
+      positionOf(model.securityCode, model.subscriberAccount);
+
+    if (position == noPosition) {
+      position = addPosition(model);
+      if (position == noPosition) {
+        return;
+      }
+    }
+
+    FillSlot booked;
+    booked.position = position;
+    booked.isSell = model.side == "Sell";
+    booked.quantity = model.fillQuantity;
+    booked.price = model.fillPrice;
+    booked.principal = model.principal;
+    booked.accrued = model.accrued;
+    booked.settlementAmount = model.settlementAmount;
+
+    shadow_[position - 1].fills += 1;
+    trade(position, booked, false);
+
+    if (FillSlot* slot = addFill(model.executionCode)) {
+      booked.executionCode = slot->executionCode;
+      *slot = booked;
+    }
+  }
+
+  void PositionBook::postTrade(const PostTradeEventModel& model)
+  {
+    FillSlot* slot = findFill(model.executionCode);
+    if (slot == nullptr) {
+      return;
+    }
+
+    trade(slot->position, *slot, true);
+
+    if (model.status == "Correct") {
+      slot->quantity = model.quantity;
+      slot->price = model.price;
+      slot->principal = model.principal;
+      slot->accrued = model.accrued;
+      slot->settlementAmount = model.settlement;
+
+      trade(slot->position, *slot, false);
+      return;
+    }
+
+    // A second cancel books nothing
+    slot->quantity = 0.0;
+    slot->price = 0.0;
+    slot->principal = 0.0;
+    slot->accrued = 0.0;
+    slot->settlementAmount = 0.0;
+  }
+
+  void PositionBook::trade(std::uint32_t index, const FillSlot& fill,
+    bool reverse)
+  {
+    PositionModel& position = shadow_[index - 1];
+    const double sign = fill.isSell != reverse ? -1.0 : 1.0;
+
+    position.principal -= sign * fill.principal;
+    position.accrued -= sign * fill.accrued;
+    position.settlementAmount -= sign * fill.settlementAmount;
+
+    double opened = fill.quantity;
+
+    // Against the position, realize what it closes first
+    if (position.quantity * sign < 0.0 && fill.quantity > 0.0) {
+      const double held = std::abs(position.quantity);
+      const double closed = std::min(fill.quantity, held);
+      const double released = position.costBasis * closed / held;
+      const double proceeds = fill.principal * closed / fill.quantity;
+      const double direction = position.quantity > 0.0 ? 1.0 : -1.0;
+
+      position.realized += direction * (proceeds - released);
+      opened -= closed;
+
+      if (closed == held) {
+        position.quantity = 0.0;
+        position.averageCost = 0.0;
+        position.costBasis = 0.0;
+      } else {
+        position.quantity += sign * closed;
+        position.costBasis -= released;
+      }
+    }
+
+    if (opened > 0.0) {
+      const double held = std::abs(position.quantity);
+
+      position.averageCost =
+        (held * position.averageCost + opened * fill.price)
+        / (held + opened);
+      position.costBasis += fill.principal * opened / fill.quantity;
+      position.quantity += sign * opened;
+    }
+
+    positions_[index - 1].store(position);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Readers
+
+  bool PositionBook::find(std::string_view securityCode,
+    std::string_view subscriberAccount, PositionModel& position) const
+  {
+    const std::uint32_t index = positionOf(securityCode, subscriberAccount);
+    if (index == noPosition) {
+      return false;
+    }
+
+    positions_[index - 1].load(position);
+    return true;
+  }
+
+  void PositionBook::snapshot(std::vector<PositionModel>& out) const
+  {
+    out.resize(size());
+
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      positions_[i].load(out[i]);
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Tables
+
+  std::size_t PositionBook::hashOf(std::string_view securityCode,
+    std::string_view subscriberAccount)
+  {
+    const std::size_t security =
+      std::hash<std::string_view>{}(securityCode);
+    const std::size_t account =
+      std::hash<std::string_view>{}(subscriberAccount);
+
+    // As boost::hash_combine
+    return security ^ (
+      account + 0x9E3779B97F4A7C15ull + (security << 6) + (security >> 2)
+    );
+  }
+
+  // Readers probe concurrently with addPosition. A slot's key is
+  // written before its position is published and never changes after.
+  std::uint32_t PositionBook::positionOf(std::string_view securityCode,
+    std::string_view subscriberAccount) const
+  {
+    // Truncated as the writer stored them
+    const SecurityCodeString security(securityCode);
+    const MpidString account(subscriberAccount);
+    std::size_t slot = hashOf(security, account) & keyMask_;
+
+    for (;;) {
+      const std::uint32_t position =
+        keys_[slot].position.load(std::memory_order_acquire);
+
+      if (position == noPosition) {
+        return noPosition;
+      }
+      if ( keys_[slot].securityCode == security
+        && keys_[slot].subscriberAccount == account
+      ) {
+        return position;
+      }
+      slot = (slot + 1) & keyMask_;
+    }
+  }
+
+  std::uint32_t PositionBook::addPosition(const FillEventModel& model)
+  {
+    const std::size_t size = size_.load(std::memory_order_relaxed);
+
+    if (size == capacity_) {
+      if (fullLimiter_.allow()) {
+        log_.logWarning("Position book full, {}/{} not tracked",
+          model.securityCode, model.subscriberAccount);
+      }
+      return noPosition;
+    }
+
+    const auto index = static_cast<std::uint32_t>(size + 1);
+
+    PositionModel& position = shadow_[size];
+    position.securityCode = model.securityCode;
+    position.securityId = model.securityId;
+    position.subscriberAccount = model.subscriberAccount;
+
+    // Complete before its key, the only way readers reach it
+    positions_[size].store(position);
+
+    std::size_t slot =
+      hashOf(position.securityCode, position.subscriberAccount) & keyMask_;
+    while (keys_[slot].position.load(std::memory_order_relaxed)
+      != noPosition
+    ) {
+      slot = (slot + 1) & keyMask_;
+    }
+
+    keys_[slot].securityCode = position.securityCode;
+    keys_[slot].subscriberAccount = position.subscriberAccount;
+    keys_[slot].position.store(index, std::memory_order_release);
+
+    size_.store(size + 1, std::memory_order_release);
+    return index;
+  }
+
+  PositionBook::FillSlot* PositionBook::findFill(
+    std::string_view executionCode)
+  {
+    // Truncated as addFill() stored it
+    const ExecutionCodeString code(executionCode);
+    std::size_t slot = std::hash<std::string_view>{}(code) & fillMask_;
+
+    while (fills_[slot].position != noPosition) {
+      if (fills_[slot].executionCode == code) {
+        return &fills_[slot];
+      }
+      slot = (slot + 1) & fillMask_;
+    }
+
+    return nullptr;
+  }
+
+  PositionBook::FillSlot* PositionBook::addFill(
+    std::string_view executionCode)
+  {
+    if (FillSlot* slot = findFill(executionCode)) {
+      return slot;
+    }
+
+    if (fillCapacity_ == 0) {
+      return nullptr;
+    }
+
+    // The oldest fill makes room, its resends would be long gone
+    if (fillCount_ == fillCapacity_) {
+      std::size_t oldest =
+        std::hash<std::string_view>{}(fillOrder_[fillNext_]) & fillMask_;
+      while (fills_[oldest].executionCode != fillOrder_[fillNext_]) {
+        oldest = (oldest + 1) & fillMask_;
+      }
+      eraseFill(oldest);
+    }
+
+    const ExecutionCodeString code(executionCode);
+    std::size_t slot = std::hash<std::string_view>{}(code) & fillMask_;
+    while (fills_[slot].position != noPosition) {
+      slot = (slot + 1) & fillMask_;
+    }
+
+    fills_[slot].executionCode = code;
+    fillOrder_[fillNext_] = code;
+    fillNext_ = (fillNext_ + 1) % fillCapacity_;
+    ++fillCount_;
+    return &fills_[slot];
+  }
+
+  // Backward shift deletion, as IOIBook's index
+  void PositionBook::eraseFill(std::size_t slot)
+  {
+    std::size_t hole = slot;
+    std::size_t next = (hole + 1) & fillMask_;
+
+    while (fills_[next].position != noPosition) {
+      const std::size_t home =
+        std::hash<std::string_view>{}(fills_[next].executionCode)
+        & fillMask_;
+
+      // Move the entry back unless its home lies after the hole
+      if (((next - home) & fillMask_) >= ((next - hole) & fillMask_)) {
+        fills_[hole] = fills_[next];
+        hole = next;
+      }
+      next = (next + 1) & fillMask_;
+    }
+
+    fills_[hole] = FillSlot {};
+    --fillCount_;
+  }
+
+} // Namespace FixClient
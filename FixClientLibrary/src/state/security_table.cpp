@@ -0,0 +1,182 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// security_table.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <bit>
+
+#include "state/security_table.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    // Per bucket tries before the slot table doubles
+    constexpr std::uint32_t maxDisplacement = 1 << 16;
+
+    // Average codes per bucket of the perfect hash
+    constexpr std::size_t codesPerBucket = 4;
+
+    // SplitMix64 finalizer over the hash and the bucket's displacement
+    std::uint64_t mix(std::uint64_t hash, std::uint32_t displacement)
+    {
+      std::uint64_t x = hash ^ (displacement * 0x9E3779B97F4A7C15ull);
+      x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+      x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+      return x ^ (x >> 31);
+    }
+
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Lookups
+
+  SecurityId SecurityTable::find(std::string_view code) const
+  {
+    if (!slots_.empty()) {
+      const SecurityId id = slots_[slotOf(hashOf(code))];
+      if (id != noSecurityId && codes_[id] == code) {
+        return id;
+      }
+    }
+
+    if (overflow_.empty()) {
+      return noSecurityId;
+    }
+
+    auto it = overflow_.find(code);
+    return it != overflow_.end() ? it->second : noSecurityId;
+  }
+
+  SecurityId SecurityTable::intern(std::string_view code)
+  {
+    SecurityId id = find(code);
+    if (id != noSecurityId) {
+      return id;
+    }
+
+    id = static_cast<SecurityId>(codes_.size());
+    codes_.emplace_back(code);
+    overflow_.emplace(codes_.back(), id);
+
+    return id;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Perfect Hash
+
+  void SecurityTable::seed(const std::vector<SecurityModel>& securities)
+  {
+    for (const SecurityModel& security : securities) {
+      intern(security.code);
+    }
+
+    std::size_t slotCount = std::bit_ceil(
+      std::max<std::size_t>(codes_.size() * 2, 8)
+    );
+    while (!buildPerfectHash(slotCount)) {
+      slotCount *= 2;
+    }
+
+    overflow_.clear();
+  }
+
+  // FNV-1a
+  std::uint64_t SecurityTable::hashOf(std::string_view code)
+  {
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (char character : code) {
+      hash ^= static_cast<unsigned char>(character);
+      hash *= 0x100000001B3ull;
+    }
+    return hash;
+  }
+
+  std::size_t SecurityTable::slotOf(std::uint64_t hash) const
+  {
+    const std::size_t bucket = (hash >> 32) & (displacements_.size() - 1);
+    return mix(hash, displacements_[bucket]) & (slots_.size() - 1);
+  }
+
+  bool SecurityTable::buildPerfectHash(std::size_t slotCount)
+  {
+    const std::size_t bucketCount = std::bit_ceil(
+      std::max<std::size_t>(codes_.size() / codesPerBucket, 1)
+    );
+
+    std::vector<std::uint64_t> hashes(codes_.size());
+    std::vector<std::vector<SecurityId>> buckets(bucketCount);
+    for (SecurityId id = 0; id < codes_.size(); ++id) {
+      hashes[id] = hashOf(codes_[id]);
+      buckets[(hashes[id] >> 32) & (bucketCount - 1)].push_back(id);
+    }
+
+    // Place the crowded buckets while the table is still empty
+    std::vector<std::size_t> order(bucketCount);
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+      [&](std::size_t lhs, std::size_t rhs) {
+        return buckets[lhs].size() > buckets[rhs].size();
+      }
+    );
+
+    std::vector<std::uint32_t> displacements(bucketCount, 0);
+    std::vector<SecurityId> slots(slotCount, noSecurityId);
+    std::vector<std::size_t> taken;
+
+    for (std::size_t bucket : order) {
+      if (buckets[bucket].empty()) {
+        break;
+      }
+
+      bool placed = false;
+      for (std::uint32_t displacement = 0;
+        displacement < maxDisplacement && !placed;
+        ++displacement
+      ) {
+        taken.clear();
+        placed = true;
+
+        for (SecurityId id : buckets[bucket]) {
+          const std::size_t slot =
+            mix(hashes[id], displacement) & (slotCount - 1);
+
+          if (slots[slot] != noSecurityId
+            || std::find(taken.begin(), taken.end(), slot) != taken.end()
+          ) {
+            placed = false;
+            break;
+          }
+          taken.push_back(slot);
+        }
+
+        if (placed) {
+          for (std::size_t i = 0; i < taken.size(); ++i) {
+            slots[taken[i]] = buckets[bucket][i];
+          }
+          displacements[bucket] = displacement;
+        }
+      }
+
+      if (!placed) {
+        return false;
+      }
+    }
+
+    displacements_ = std::move(displacements);
+    slots_ = std::move(slots);
+    return true;
+  }
+
+} // Namespace FixClient
@@ -0,0 +1,135 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// top_of_book.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include "state/top_of_book.hpp"
+
+namespace FixClient {
+
+  std::optional<TopOfBookEntry> toTopOfBookEntry(char entryType)
+  {
+    switch (entryType) {
+      case FIX::MDEntryType_BID: return TopOfBookEntry::Bid;
+      case FIX::MDEntryType_OFFER: return TopOfBookEntry::Offer;
+      case FIX::MDEntryType_TRADE: return TopOfBookEntry::Trade;
+      case FIX::MDEntryType_INDEX_VALUE: return TopOfBookEntry::Index;
+      case FIX::MDEntryType_OPENING_PRICE: return TopOfBookEntry::Open;
+      case FIX::MDEntryType_TRADING_SESSION_HIGH_PRICE:
+        return TopOfBookEntry::High;
+      case FIX::MDEntryType_TRADING_SESSION_LOW_PRICE:
+        return TopOfBookEntry::Low;
+    }
+    return std::nullopt;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Top of Book Table
+
+  TopOfBookTable::TopOfBookTable(SecurityTable& securities) :
+    securities_(securities)
+  {
+    // Nada
+  }
+
+  const TopOfBookModel* TopOfBookTable::find(SecurityId securityId) const
+  {
+    if (securityId >= rows_.size() || !active_[securityId]) {
+      return nullptr;
+    }
+    return &rows_[securityId];
+  }
+
+  const TopOfBookModel* TopOfBookTable::find(
+    std::string_view securityCode) const
+  {
+    return find(securities_.find(securityCode));
+  }
+
+  void TopOfBookTable::clear()
+  {
+    rows_.clear();
+    active_.clear();
+    activeCount_ = 0;
+    codes_.clear();
+    touched_.clear();
+    seen_.clear();
+    snapshotRows_.clear();
+  }
+
+  SecurityId TopOfBookTable::rowFor(const MarketDataModel& model)
+  {
+    const SecurityId row = model.securityId != noSecurityId
+      ? model.securityId
+      : securities_.intern(model.securityCode);
+
+    if (row >= rows_.size()) {
+      rows_.resize(row + 1);
+      active_.resize(row + 1, 0);
+      seen_.resize(row + 1, 0);
+      codes_.resize(row + 1);
+    }
+
+    if (!active_[row]) {
+      codes_[row] = model.securityCode;
+      active_[row] = 1;
+      ++activeCount_;
+    }
+
+    return row;
+  }
+
+  void TopOfBookTable::apply(SecurityId row, const MarketDataModel& model)
+  {
+    std::optional<TopOfBookEntry> entry = toTopOfBookEntry(model.entryType);
+    if (!entry.has_value()) {
+      return;
+    }
+
+    TopOfBookLevel& level = rows_[row].levels[
+      static_cast<std::size_t>(entry.value())
+    ];
+
+    TopOfBookLevel updated;
+    switch (model.action) {
+      case FIX::MDUpdateAction_NEW:
+      case FIX::MDUpdateAction_CHANGE:
+        updated = TopOfBookLevel {
+          .quantity = model.quantity,
+          .price = model.price,
+          .yield = model.yield,
+          .present = true
+        };
+        break;
+      case FIX::MDUpdateAction_DELETE:
+        break;
+      default:
+        return;
+    }
+
+    if (level == updated) {
+      return;
+    }
+
+    level = updated;
+    touch(row, entry.value());
+  }
+
+  void TopOfBookTable::touch(SecurityId row, TopOfBookEntry entry)
+  {
+    TopOfBookModel& model = rows_[row];
+    if (model.changed == 0) {
+      touched_.push_back(row);
+    }
+    model.changed |= 1 << static_cast<int>(entry);
+  }
+
+} // Namespace FixClient
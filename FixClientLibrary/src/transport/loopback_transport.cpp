@@ -0,0 +1,288 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// loopback_transport.cpp
+// FixClientLibrary
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include "transport/loopback_transport.hpp"
+
+namespace FixClient {
+
+  namespace {
+
+    constexpr const char* beginString = "FIX.4.4";
+
+    constexpr const char* suffixes[] = { "-MD", "-OB", "-TR" };
+
+    // How often the session timers run
+    constexpr auto tickInterval = std::chrono::milliseconds(1);
+
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Pipe
+
+  // One direction of a session pair. QuickFIX calls it with every
+  // serialized message, on whichever thread sent it.
+  class LoopbackTransport::Pipe : public FIX::Responder
+  {
+
+    public:
+
+      Pipe(LoopbackTransport& transport, const FIX::SessionID& clientSessionID,
+        bool toClient) :
+        transport_(transport),
+        clientSessionID_(clientSessionID),
+        toClient_(toClient)
+      {
+        // Nada
+      }
+
+      void connect(FIX::Session* to)
+      {
+        to_ = to;
+      }
+
+      bool send(const std::string& message) override
+      {
+        if (!toClient_ && transport_.tap_) {
+          transport_.tap_(
+            LoopbackDirection::FromClient, clientSessionID_, message
+          );
+        }
+
+        transport_.push(Delivery {
+          .to = to_,
+          .message = message,
+          .disconnect = false,
+          .clientSessionID = toClient_ ? &clientSessionID_ : nullptr
+        });
+        return true;
+      }
+
+      void disconnect() override
+      {
+        transport_.push(Delivery {
+          .to = to_,
+          .message = {},
+          .disconnect = true,
+          .clientSessionID = nullptr
+        });
+      }
+
+    private:
+
+      LoopbackTransport& transport_;
+
+      const FIX::SessionID& clientSessionID_;
+
+      bool toClient_;
+
+      FIX::Session* to_ { nullptr };
+
+  };
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Loopback Transport
+
+  LoopbackTransport::LoopbackTransport(FIX::Application& client,
+    FIX::Application& venue, const LoopbackOptions& options,
+    LoopbackTap tap) :
+    client_(client),
+    venue_(venue),
+    options_(options),
+    tap_(std::move(tap))
+  {
+    for (const char* suffix : suffixes) {
+      clientSessions_.emplace_back(beginString,
+        options_.compId + suffix, options_.venueId + suffix);
+      venueSessions_.emplace_back(beginString,
+        options_.venueId + suffix, options_.compId + suffix);
+    }
+
+    dictionaries_.addTransportDataDictionary(
+      FIX::BeginString(beginString), options_.dataDictionary
+    );
+  }
+
+  LoopbackTransport::~LoopbackTransport()
+  {
+    stop();
+  }
+
+  void LoopbackTransport::start()
+  {
+    // Start and end the same time, always in session
+    const FIX::TimeRange always(
+      FIX::UtcTimeOnly(0, 0, 0), FIX::UtcTimeOnly(0, 0, 0)
+    );
+
+    for (std::size_t i = 0; i < clientSessions_.size(); ++i) {
+      // A heartbeat interval makes an initiator, none an acceptor
+      auto client = std::make_unique<FIX::Session>(client_, storeFactory_,
+        clientSessions_[i], dictionaries_, always, options_.heartBtInt,
+        nullptr);
+      auto venue = std::make_unique<FIX::Session>(venue_, storeFactory_,
+        venueSessions_[i], dictionaries_, always, 0, nullptr);
+
+      auto fromClient =
+        std::make_unique<Pipe>(*this, clientSessions_[i], false);
+      auto toClient =
+        std::make_unique<Pipe>(*this, clientSessions_[i], true);
+
+      fromClient->connect(venue.get());
+      toClient->connect(client.get());
+      client->setResponder(fromClient.get());
+      venue->setResponder(toClient.get());
+
+      pipes_.push_back(std::move(fromClient));
+      pipes_.push_back(std::move(toClient));
+      sessions_.push_back(std::move(client));
+      sessions_.push_back(std::move(venue));
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&LoopbackTransport::run, this);
+  }
+
+  void LoopbackTransport::stop()
+  {
+    if (!thread_.joinable()) {
+      return;
+    }
+
+    for (const FIX::SessionID& sessionID : clientSessions_) {
+      FIX::Session* session = FIX::Session::lookupSession(sessionID);
+      if (session) {
+        session->logout();
+      }
+    }
+
+    const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while ( !allLoggedOn(false)
+      && std::chrono::steady_clock::now() < deadline
+    ) {
+      std::this_thread::sleep_for(tickInterval);
+    }
+
+    running_.store(false, std::memory_order_release);
+    wake_.notify_one();
+    thread_.join();
+
+    sessions_.clear();
+    pipes_.clear();
+    queue_.clear();
+  }
+
+  bool LoopbackTransport::waitForLogon(std::chrono::milliseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!allLoggedOn(true)) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(tickInterval);
+    }
+    return true;
+  }
+
+  bool LoopbackTransport::allLoggedOn(bool loggedOn)
+  {
+    for (const FIX::SessionID& sessionID : clientSessions_) {
+      FIX::Session* session = FIX::Session::lookupSession(sessionID);
+      if (!session || session->isLoggedOn() != loggedOn) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Moving Messages
+
+  void LoopbackTransport::push(Delivery&& delivery)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push_back(std::move(delivery));
+      pending_.store(true, std::memory_order_release);
+    }
+
+    if (!options_.spin) {
+      wake_.notify_one();
+    }
+  }
+
+  // Delivering may queue more, answers and heartbeats, so the queue is
+  // swapped out and never locked while a session runs
+  void LoopbackTransport::run()
+  {
+    std::deque<Delivery> batch;
+    auto nextTick = std::chrono::steady_clock::now();
+
+    while (running_.load(std::memory_order_acquire)) {
+      if (options_.spin) {
+        if (pending_.load(std::memory_order_acquire)) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          batch.swap(queue_);
+          pending_.store(false, std::memory_order_relaxed);
+        }
+      } else {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait_until(lock, nextTick, [this] {
+          return !queue_.empty()
+            || !running_.load(std::memory_order_acquire);
+        });
+        batch.swap(queue_);
+        pending_.store(false, std::memory_order_relaxed);
+      }
+
+      for (Delivery& delivery : batch) {
+        deliver(delivery);
+      }
+      batch.clear();
+
+      if (std::chrono::steady_clock::now() >= nextTick) {
+        tick();
+        nextTick = std::chrono::steady_clock::now() + tickInterval;
+      }
+    }
+  }
+
+  void LoopbackTransport::deliver(Delivery& delivery)
+  {
+    if (delivery.disconnect) {
+      delivery.to->disconnect();
+      return;
+    }
+
+    if (delivery.clientSessionID && tap_) {
+      tap_(LoopbackDirection::ToClient, *delivery.clientSessionID,
+        delivery.message);
+    }
+
+    // The session logged it already, a socket reader would drop it too
+    try {
+      delivery.to->next(delivery.message, FIX::UtcTimeStamp());
+    } catch (const FIX::InvalidMessage&) {
+      // Nada
+    }
+  }
+
+  void LoopbackTransport::tick()
+  {
+    for (const std::unique_ptr<FIX::Session>& session : sessions_) {
+      session->next(FIX::UtcTimeStamp());
+    }
+  }
+
+} // Namespace FixClient
@@ -11,15 +11,29 @@
 //
 // -------- -------- -------- -------- -------- -------- -------- --------
 
+#include <exception>
+
 #include "workflow.hpp"
 
 namespace FixClient {
 
   WorkflowInterface::WorkflowInterface(
-    const std::string& compId
+    const std::string& compId,
+    std::size_t orderCapacity,
+    const RiskLimits& risk,
+    const ThrottleLimits& throttle,
+    std::size_t submitCapacity
   ) :
-    orderDispatch_(compId)
-  {}
+    orders_(orderCapacity),
+    orderDispatch_(compId, risk, throttle),
+    submitter_(submitCapacity,
+      [this](const OrderModel& model) { return sendOrder(model); }
+    )
+  {
+    orderDispatch_.onQueuedSendFailed([this](const OrderModel& model) {
+      sendFailed(model);
+    });
+  }
 
   void WorkflowInterface::onLogon(
     [[ maybe_unused ]] const std::string& senderId) const
@@ -45,6 +59,12 @@ namespace FixClient {
     // Do nothing by default
   }
   
+  void WorkflowInterface::onSecurityList(
+    [[ maybe_unused ]] const std::vector<SecurityModel>& securities) const
+  {
+    // Do nothing by default
+  }
+
   void WorkflowInterface::onSessionState(
     [[ maybe_unused ]] const SessionStateModel& model) const
   {
@@ -79,9 +99,110 @@ namespace FixClient {
     // Do nothing by default
   }
   
-  void WorkflowInterface::sendOrder(const OrderModel& model)
+  RiskCheck WorkflowInterface::sendOrder(const OrderModel& model)
+  {
+    std::string originalOrderCode;
+
+    switch (orderDispatch_.replaces().submit(model, originalOrderCode)) {
+      case Coalesced::Send:
+        break;
+
+      case Coalesced::Rerouted: {
+        OrderModel rerouted = model;
+        rerouted.originalOrderCode = originalOrderCode;
+        return send(rerouted);
+      }
+
+      case Coalesced::Held:
+        return RiskCheck::Passed;
+    }
+
+    return send(model);
+  }
+
+  SubmissionTicket WorkflowInterface::submitOrder(const OrderModel& model)
+  {
+    return submitter_.submit(model);
+  }
+
+  RiskCheck WorkflowInterface::send(const OrderModel& model)
+  {
+    // Before its execution report can arrive, and to know the exposure
+    // the gate has to reserve
+    const ExposureChange sent = orders_.onOrderSent(model);
+    RiskCheck result = RiskCheck::Passed;
+
+    try {
+      result = orderDispatch_.sendOrder(model, sent.change, sent.tracked);
+    } catch (...) {
+      sendFailed(model);
+      throw;
+    }
+
+    // Blocked, the gate reserved nothing
+    if (result != RiskCheck::Passed) {
+      orders_.onSendFailed(model);
+      orderDispatch_.replaces().onSendFailed(model);
+    }
+
+    return result;
+  }
+
+  void WorkflowInterface::sendFailed(const OrderModel& model)
   {
-    orderDispatch_.sendOrder(model);
+    const ExposureChange failed = orders_.onSendFailed(model);
+    orderDispatch_.risk().adjust(failed.securityCode, failed.change);
+    orderDispatch_.replaces().onSendFailed(model);
+  }
+
+  bool WorkflowInterface::applyExecution(const ExecutionEventModel& event,
+    ExecutionEventModel& notSent)
+  {
+    const ExposureChange applied = orders_.apply(event);
+    orderDispatch_.risk().adjust(applied.securityCode, applied.change);
+
+    OrderModel amendment {};
+    if (!orderDispatch_.replaces().onExecution(event, amendment)) {
+      return false;
+    }
+
+    std::string reason;
+
+    // On the engine's thread, which must not see the send fail
+    try {
+      const RiskCheck result = send(amendment);
+      if (result == RiskCheck::Passed) {
+        return false;
+      }
+      reason = toString(result);
+    } catch (const std::exception& e) {
+      reason = e.what();
+    }
+
+    Log log;
+    log.logError("Replace {} not sent: {}", amendment.orderCode, reason);
+
+    notSent.orderCode = amendment.orderCode;
+    notSent.value = RejectEventModel {
+      .status = FIX::OrdRejReason_OTHER,
+      .message = "Not sent: " + reason
+    };
+    return true;
+  }
+
+  void WorkflowInterface::applySessionState(const SessionStateModel& model)
+  {
+    orderDispatch_.risk().onSessionState(model);
+  }
+
+  void WorkflowInterface::attachSession(const FIX::SessionID& sessionID)
+  {
+    orderDispatch_.session().attach(sessionID);
+  }
+
+  void WorkflowInterface::detachSession(const FIX::SessionID& sessionID)
+  {
+    orderDispatch_.session().detach(sessionID);
   }
   
   void WorkflowInterface::requestSecurityList()
@@ -92,10 +213,7 @@ namespace FixClient {
       FIX::SecurityListRequestType_ALL_SECURITIES)
     );
     
-    FIX::Session::sendToTarget(message,
-      FIX::SenderCompID(orderDispatch_.senderCompId()),
-      FIX::TargetCompID("OPENYIELD-TR")
-    );
+    orderDispatch_.session().send(message);
 
   }
   
@@ -109,10 +227,7 @@ namespace FixClient {
     // For shared connections, set the PartyRole_CLIENT_ID in a
     // party group to cancel orders for that party only
 
-    FIX::Session::sendToTarget(message,
-      FIX::SenderCompID(orderDispatch_.senderCompId()),
-      FIX::TargetCompID("OPENYIELD-TR")
-    );
+    orderDispatch_.session().send(message);
     
   }
 
@@ -0,0 +1,145 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// main.cpp
+// FixClientReplay
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Replays a journal written by FixEngine::journalTo() through a
+// FixEngine and a workflow that only counts, and prints the throughput.
+//
+//   fixclient_replay <journal> <FIX44.xml> [--recorded] [--raw]
+//
+// --recorded keeps the recorded pace, with gaps capped at a second,
+// --raw decodes incrementals with MarketDataDecoder::Raw. Built with
+// FIXCLIENT_LATENCY_METRICS, it also prints the per-stage latencies.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include <fmt/core.h>
+
+#include "fix_engine.hpp"
+#include "journal/journal_replay.hpp"
+
+using namespace FixClient;
+
+namespace {
+
+  // -------- -------- -------- --------
+  // MARK: Counting Workflow
+
+  class CountingWorkflow final : public WorkflowInterface
+  {
+    public:
+
+      CountingWorkflow() : WorkflowInterface("REPLAY") {}
+
+      void onMarketData(
+        const std::vector<MarketDataModel>& model) const override
+      {
+        entries_ += model.size();
+      }
+
+      void onOIOOrderBook(
+        [[ maybe_unused ]] const IOIOrderModel& model) const override
+      {
+        ++events_;
+      }
+
+      void onFillEvent(
+        [[ maybe_unused ]] const std::string& orderCode,
+        [[ maybe_unused ]] const FillEventModel& model) const override
+      {
+        ++events_;
+      }
+
+      void onSessionState(
+        [[ maybe_unused ]] const SessionStateModel& model) const override
+      {
+        ++events_;
+      }
+
+      mutable std::uint64_t entries_ { 0 };
+      mutable std::uint64_t events_ { 0 };
+  };
+
+  int usage()
+  {
+    fmt::print(stderr,
+      "usage: fixclient_replay <journal> <FIX44.xml> [--recorded] [--raw]\n"
+    );
+    return 2;
+  }
+
+}
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Main
+
+int main(int argc, char* argv[])
+{
+  if (argc < 3) {
+    return usage();
+  }
+
+  ReplayPace pace = ReplayPace::Max;
+  MarketDataDecoder decoder = MarketDataDecoder::QuickFix;
+
+  for (int i = 3; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--recorded") == 0) {
+      pace = ReplayPace::Recorded;
+    } else if (std::strcmp(argv[i], "--raw") == 0) {
+      decoder = MarketDataDecoder::Raw;
+    } else {
+      return usage();
+    }
+  }
+
+  try {
+    MessageJournalReader reader(argv[1]);
+    FIX::DataDictionary dictionary(argv[2]);
+
+    auto workflow = std::make_shared<CountingWorkflow>();
+    BasicFixEngine<CountingWorkflow> engine(workflow, decoder);
+
+    const ReplayStats stats = replayJournal(reader, engine, dictionary, pace);
+
+    const double seconds = stats.elapsed.count() / 1e9;
+
+    fmt::print("{} messages, {} failed, in {:.3f} s\n",
+      stats.messages, stats.failed, seconds);
+    if (stats.messages > 0 && seconds > 0) {
+      fmt::print("{:.0f} messages/s, {:.0f} ns/message\n",
+        stats.messages / seconds,
+        stats.elapsed.count() / static_cast<double>(stats.messages));
+    }
+    fmt::print("{} market data entries, {} other events\n",
+      workflow->entries_, workflow->events_);
+
+    for (const LatencySummary& summary : engine.latencySummaries()) {
+      fmt::print(
+        "{:<22} {:<8} {:>10} p50 {:>8.0f} p99 {:>8.0f} "
+        "p99.9 {:>8.0f} max {:>10.0f} ns\n",
+        toString(summary.message), toString(summary.stage), summary.count,
+        summary.p50, summary.p99, summary.p999, summary.max
+      );
+    }
+  } catch (const std::exception& e) {
+    fmt::print(stderr, "fixclient_replay: {}\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
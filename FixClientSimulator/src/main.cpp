@@ -0,0 +1,109 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// main.cpp
+// FixClientSimulator
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// A local OpenYield venue to load test a client against, see
+// simulator.cfg for the acceptor settings.
+//
+//   fixclient_simulator <acceptor.cfg> [--md-rate 1000] ...
+//
+// Runs until SIGINT or SIGTERM, then prints what it sent and received.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <exception>
+#include <optional>
+#include <thread>
+
+#include <fmt/core.h>
+
+#include "quickfix.hpp"
+
+// Not in quickfix.hpp, the library only initiates
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#include <quickfix/SocketAcceptor.h>
+#pragma GCC diagnostic pop
+
+#include "market_feed.hpp"
+#include "simulator_options.hpp"
+#include "venue.hpp"
+
+using namespace FixClientSimulator;
+
+namespace {
+
+  std::atomic<bool> interrupted { false };
+
+  void onSignal([[ maybe_unused ]] int signal)
+  {
+    interrupted.store(true);
+  }
+
+}
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Main
+
+int main(int argc, char* argv[])
+{
+  const std::optional<SimulatorOptions> options = parseOptions(argc, argv);
+  if (!options.has_value()) {
+    printUsage();
+    return 2;
+  }
+
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+
+  try {
+    const std::vector<SimulatedSecurity> securities =
+      makeSecurities(options.value());
+
+    Venue venue(options.value(), securities);
+    MarketFeed feed(venue, options.value(), securities);
+
+    FIX::SessionSettings settings(options->settingsPath, true);
+    FIX::FileStoreFactory storeFactory(settings);
+    FIX::FileLogFactory logFactory(settings);
+    FIX::SocketAcceptor acceptor(venue, storeFactory, settings, logFactory);
+
+    acceptor.start();
+    feed.start();
+
+    fmt::print("Simulating {} securities, {} incrementals/s, {} IOIs/s\n",
+      securities.size(), options->marketDataRate, options->ioiRate);
+
+    while (!interrupted.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    feed.stop();
+    acceptor.stop();
+
+    const FeedStats feedStats = feed.stats();
+    const VenueStats venueStats = venue.stats();
+
+    fmt::print("{} snapshots, {} incrementals, {} IOIs sent\n",
+      feedStats.snapshots, feedStats.incrementals, feedStats.iois);
+    fmt::print("{} orders received, {} execution reports sent\n",
+      venueStats.orders, venueStats.executionReports);
+  } catch (const std::exception& e) {
+    fmt::print(stderr, "fixclient_simulator: {}\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,292 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// market_feed.cpp
+// FixClientSimulator
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+
+#include <fmt/core.h>
+
+#include "market_feed.hpp"
+
+namespace FixClientSimulator {
+
+  namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr auto tick = std::chrono::milliseconds(1);
+
+    // A 32nd apart, the bid below the mid
+    constexpr double halfSpread = 1.0 / 64.0;
+
+    // A 128th at a time, within five points of par
+    constexpr double step = 1.0 / 128.0;
+    constexpr double lowest = 95.0;
+    constexpr double highest = 105.0;
+
+  }
+
+  MarketFeed::MarketFeed(const Venue& venue, const SimulatorOptions& options,
+    std::vector<SimulatedSecurity> securities) :
+    venue_(venue),
+    options_(options),
+    securities_(std::move(securities)),
+    random_(options.seed),
+    iois_(securities_.size())
+  {
+    // Nada
+  }
+
+  MarketFeed::~MarketFeed()
+  {
+    stop();
+  }
+
+  void MarketFeed::start()
+  {
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&MarketFeed::run, this);
+  }
+
+  void MarketFeed::stop()
+  {
+    running_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  FeedStats MarketFeed::stats() const
+  {
+    return FeedStats {
+      .snapshots = snapshots_.load(std::memory_order_relaxed),
+      .incrementals = incrementals_.load(std::memory_order_relaxed),
+      .iois = ioiCount_.load(std::memory_order_relaxed)
+    };
+  }
+
+  void MarketFeed::run()
+  {
+    // Fractions carry over to the next tick
+    const double incrementalsPerTick = options_.marketDataRate / 1000.0;
+    const double ioisPerTick = options_.ioiRate / 1000.0;
+    double incrementalsDue = 0;
+    double ioisDue = 0;
+
+    Clock::time_point nextTick = Clock::now();
+    Clock::time_point nextStatus = nextTick + options_.statusInterval;
+
+    while (running_.load(std::memory_order_acquire)) {
+      refreshSessions();
+
+      if (!marketData_.empty()) {
+        incrementalsDue += incrementalsPerTick;
+        for (; incrementalsDue >= 1; incrementalsDue -= 1) {
+          sendIncremental();
+        }
+      }
+
+      if (!orderBook_.empty()) {
+        ioisDue += ioisPerTick;
+        for (; ioisDue >= 1; ioisDue -= 1) {
+          sendIOI();
+        }
+      }
+
+      if (Clock::now() >= nextStatus) {
+        for (const FIX::SessionID& sessionID : trading_) {
+          sendStatus(sessionID);
+        }
+        nextStatus += options_.statusInterval;
+      }
+
+      // Falls behind rather than bursting if a tick overran
+      nextTick = std::max(nextTick + tick, Clock::now());
+      std::this_thread::sleep_until(nextTick);
+    }
+  }
+
+  void MarketFeed::refreshSessions()
+  {
+    const std::uint64_t generation = venue_.sessionsGeneration();
+    if (generation == generation_) {
+      return;
+    }
+    generation_ = generation;
+
+    // New sessions get their opening state
+    std::vector<FIX::SessionID> marketData =
+      venue_.sessions(SessionRole::MarketData);
+    for (const FIX::SessionID& sessionID : marketData) {
+      if (std::find(marketData_.begin(), marketData_.end(), sessionID)
+        == marketData_.end()) {
+        sendSnapshots(sessionID);
+      }
+    }
+
+    std::vector<FIX::SessionID> trading =
+      venue_.sessions(SessionRole::Trading);
+    for (const FIX::SessionID& sessionID : trading) {
+      if (std::find(trading_.begin(), trading_.end(), sessionID)
+        == trading_.end()) {
+        sendStatus(sessionID);
+      }
+    }
+
+    marketData_ = std::move(marketData);
+    trading_ = std::move(trading);
+    orderBook_ = venue_.sessions(SessionRole::OrderBook);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: OPENYIELD-MD
+
+  void MarketFeed::sendSnapshots(const FIX::SessionID& sessionID)
+  {
+    for (const SimulatedSecurity& security : securities_) {
+      FIX44::MarketDataSnapshotFullRefresh message;
+      message.set(FIX::SecurityID(security.code));
+
+      const struct {
+        char entryType;
+        double price;
+      } entries[] = {
+        { FIX::MDEntryType_BID, security.price - halfSpread },
+        { FIX::MDEntryType_OFFER, security.price + halfSpread },
+        { FIX::MDEntryType_TRADE, security.price }
+      };
+
+      for (const auto& entry : entries) {
+        FIX44::MarketDataSnapshotFullRefresh::NoMDEntries group;
+        group.set(FIX::MDEntryType(entry.entryType));
+        group.set(FIX::MDEntryPx(entry.price));
+        group.set(FIX::MDEntrySize(1000000));
+        group.set(FIX::PriceDelta(security.yield));
+        message.addGroup(group);
+      }
+
+      FIX::Session::sendToTarget(message, sessionID);
+      snapshots_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void MarketFeed::sendIncremental()
+  {
+    if (securities_.empty()) {
+      return;
+    }
+
+    std::uniform_int_distribution<std::size_t> pick(
+      0, securities_.size() - 1
+    );
+
+    FIX44::MarketDataIncrementalRefresh message;
+
+    for (std::size_t i = 0; i < options_.marketDataEntries; ++i) {
+      SimulatedSecurity& security = securities_[pick(random_)];
+      walk(security);
+
+      const bool bid = random_() % 2 == 0;
+      const double price = bid
+        ? security.price - halfSpread
+        : security.price + halfSpread;
+
+      FIX44::MarketDataIncrementalRefresh::NoMDEntries group;
+      group.set(FIX::MDUpdateAction(FIX::MDUpdateAction_CHANGE));
+      group.set(FIX::MDEntryType(
+        bid ? FIX::MDEntryType_BID : FIX::MDEntryType_OFFER
+      ));
+      group.set(FIX::SecurityID(security.code));
+      group.set(FIX::MDEntryPx(price));
+      group.set(FIX::MDEntrySize(250000.0 * (1 + random_() % 8)));
+      group.set(FIX::PriceDelta(security.yield));
+      message.addGroup(group);
+    }
+
+    for (const FIX::SessionID& sessionID : marketData_) {
+      FIX::Session::sendToTarget(message, sessionID);
+    }
+    incrementals_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void MarketFeed::walk(SimulatedSecurity& security)
+  {
+    const double move = (static_cast<int>(random_() % 3) - 1) * step;
+    const double price = std::clamp(security.price + move, lowest, highest);
+
+    // Yield moves an eighth as much, the other way
+    security.yield -= (price - security.price) / 8.0;
+    security.price = price;
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: OPENYIELD-OB
+
+  // Mostly replaces, the odd cancel, a new IOI where none is live
+  void MarketFeed::sendIOI()
+  {
+    if (securities_.empty()) {
+      return;
+    }
+
+    const std::size_t index = random_() % securities_.size();
+    const SimulatedSecurity& security = securities_[index];
+    LiveIOI& live = iois_[index];
+
+    char transType = FIX::IOITransType_REPLACE;
+    if (live.ioiId.empty()) {
+      transType = FIX::IOITransType_NEW;
+      live.ioiId = fmt::format("SIMIOI{:010d}", nextIOIId_++);
+      live.side = random_() % 2 == 0 ? FIX::Side_BUY : FIX::Side_SELL;
+    } else if (random_() % 8 == 0) {
+      transType = FIX::IOITransType_CANCEL;
+    }
+
+    const double price = live.side == FIX::Side_BUY
+      ? security.price - halfSpread
+      : security.price + halfSpread;
+
+    FIX44::IOI message(
+      FIX::IOIID(live.ioiId),
+      FIX::IOITransType(transType),
+      FIX::Side(live.side),
+      FIX::IOIQty(std::to_string(250000 * (1 + random_() % 8)))
+    );
+    message.set(FIX::SecurityID(security.code));
+    message.set(FIX::Price(price));
+    message.set(FIX::Yield(security.yield));
+    message.set(FIX::IOIQltyInd(FIX::IOIQltyInd_HIGH));
+
+    for (const FIX::SessionID& sessionID : orderBook_) {
+      FIX::Session::sendToTarget(message, sessionID);
+    }
+    ioiCount_.fetch_add(1, std::memory_order_relaxed);
+
+    if (transType == FIX::IOITransType_CANCEL) {
+      live.ioiId.clear();
+    }
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: OPENYIELD-TR
+
+  void MarketFeed::sendStatus(const FIX::SessionID& sessionID)
+  {
+    FIX44::TradingSessionStatus message(
+      FIX::TradingSessionID("OPENYIELD"),
+      FIX::TradSesStatus(FIX::TradSesStatus_OPEN)
+    );
+
+    FIX::Session::sendToTarget(message, sessionID);
+  }
+
+} // Namespace FixClientSimulator
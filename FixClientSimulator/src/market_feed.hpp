@@ -0,0 +1,119 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// market_feed.hpp
+// FixClientSimulator
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// The venue's unsolicited traffic, from one thread:
+//
+// - A snapshot per security when an -MD session logs on, then
+//   incremental refreshes at the configured rate, prices on a random walk
+// - IOIs on -OB sessions, new, replaced and canceled
+// - TradingSessionStatus OPEN on -TR sessions at logon and every
+//   statusInterval
+//
+// Rates are kept on a 1 ms tick, whatever is due is sent in one go.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "quickfix.hpp"
+
+#include "simulator_options.hpp"
+#include "venue.hpp"
+
+namespace FixClientSimulator {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Feed Stats
+
+  struct FeedStats
+  {
+    std::uint64_t snapshots { 0 };
+    std::uint64_t incrementals { 0 };
+    std::uint64_t iois { 0 };
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Market Feed
+
+  class MarketFeed
+  {
+
+  public:
+
+    MarketFeed(const Venue& venue, const SimulatorOptions& options,
+      std::vector<SimulatedSecurity> securities);
+
+    ~MarketFeed();
+
+    void start();
+
+    void stop();
+
+    FeedStats stats() const;
+
+  private:
+
+    struct LiveIOI
+    {
+      std::string ioiId;
+      char side;
+    };
+
+    void run();
+
+    // Picks up logons and logouts
+    void refreshSessions();
+
+    void sendSnapshots(const FIX::SessionID& sessionID);
+
+    void sendIncremental();
+
+    void sendIOI();
+
+    void sendStatus(const FIX::SessionID& sessionID);
+
+    void walk(SimulatedSecurity& security);
+
+    const Venue& venue_;
+    const SimulatorOptions& options_;
+    std::vector<SimulatedSecurity> securities_;
+
+    std::mt19937_64 random_;
+
+    std::uint64_t generation_ { ~0ULL };
+    std::vector<FIX::SessionID> marketData_;
+    std::vector<FIX::SessionID> orderBook_;
+    std::vector<FIX::SessionID> trading_;
+
+    // One per security, at most
+    std::vector<LiveIOI> iois_;
+    std::uint64_t nextIOIId_ { 1 };
+
+    std::thread thread_;
+    std::atomic<bool> running_ { false };
+
+    std::atomic<std::uint64_t> snapshots_ { 0 };
+    std::atomic<std::uint64_t> incrementals_ { 0 };
+    std::atomic<std::uint64_t> ioiCount_ { 0 };
+
+  };
+
+} // Namespace FixClientSimulator
@@ -0,0 +1,105 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// simulator_options.cpp
+// FixClientSimulator
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+#include "simulator_options.hpp"
+
+namespace FixClientSimulator {
+
+  std::optional<SimulatorOptions> parseOptions(int argc, char* argv[])
+  {
+    if (argc < 2) {
+      return std::nullopt;
+    }
+
+    SimulatorOptions options;
+    options.settingsPath = argv[1];
+
+    try {
+      for (int i = 2; i + 1 < argc; i += 2) {
+        const char* name = argv[i];
+        const std::string value = argv[i + 1];
+
+        if (std::strcmp(name, "--securities") == 0) {
+          options.securities = std::stoul(value);
+        } else if (std::strcmp(name, "--md-rate") == 0) {
+          options.marketDataRate = std::stod(value);
+        } else if (std::strcmp(name, "--md-entries") == 0) {
+          options.marketDataEntries = std::stoul(value);
+        } else if (std::strcmp(name, "--ioi-rate") == 0) {
+          options.ioiRate = std::stod(value);
+        } else if (std::strcmp(name, "--status-interval") == 0) {
+          options.statusInterval = std::chrono::seconds(std::stol(value));
+        } else if (std::strcmp(name, "--fills") == 0) {
+          options.fills = std::stoul(value);
+        } else if (std::strcmp(name, "--reject-every") == 0) {
+          options.rejectEvery = std::stoul(value);
+        } else if (std::strcmp(name, "--correct-every") == 0) {
+          options.correctEvery = std::stoul(value);
+        } else if (std::strcmp(name, "--seed") == 0) {
+          options.seed = std::stoull(value);
+        } else {
+          return std::nullopt;
+        }
+      }
+    } catch (const std::logic_error&) {
+      return std::nullopt;
+    }
+
+    // Options come in pairs
+    if ( argc % 2 != 0
+      || options.securities == 0
+      || options.securities > 10000
+    ) {
+      return std::nullopt;
+    }
+
+    return options;
+  }
+
+  void printUsage()
+  {
+    fmt::print(stderr,
+      "usage: fixclient_simulator <acceptor.cfg>\n"
+      "  [--securities 500] [--md-rate 1000] [--md-entries 4]\n"
+      "  [--ioi-rate 100] [--status-interval 30] [--fills 2]\n"
+      "  [--reject-every 0] [--correct-every 0] [--seed 1]\n"
+    );
+  }
+
+  std::vector<SimulatedSecurity> makeSecurities(const SimulatorOptions& options)
+  {
+    std::mt19937_64 random(options.seed);
+    std::uniform_real_distribution<double> price(95.0, 105.0);
+    std::uniform_real_distribution<double> yield(3.5, 5.0);
+
+    std::vector<SimulatedSecurity> securities;
+    securities.reserve(options.securities);
+
+    for (std::size_t i = 0; i < options.securities; ++i) {
+      securities.push_back(SimulatedSecurity {
+        .code = fmt::format("US91282C{:04d}", i % 10000),
+        .price = price(random),
+        .yield = yield(random)
+      });
+    }
+
+    return securities;
+  }
+
+} // Namespace FixClientSimulator
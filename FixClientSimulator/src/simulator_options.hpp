@@ -0,0 +1,80 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// simulator_options.hpp
+// FixClientSimulator
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace FixClientSimulator {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Simulator Options
+
+  struct SimulatorOptions
+  {
+    // QuickFIX acceptor settings, see simulator.cfg
+    std::string settingsPath;
+
+    // Up to 10000
+    std::size_t securities { 500 };
+
+    // Incremental refreshes per second, and entries in each
+    double marketDataRate { 1000 };
+    std::size_t marketDataEntries { 4 };
+
+    // IOIs per second
+    double ioiRate { 100 };
+
+    // Between TradingSessionStatus messages
+    std::chrono::seconds statusInterval { 30 };
+
+    // Fills per accepted order, the last one completes it. 0 leaves
+    // orders open to be replaced or canceled.
+    std::size_t fills { 2 };
+
+    // Reject every Nth new order, 0 never
+    std::size_t rejectEvery { 0 };
+
+    // Correct every Nth fill, 0 never
+    std::size_t correctEvery { 0 };
+
+    std::uint64_t seed { 1 };
+  };
+
+  // Empty on bad arguments
+  std::optional<SimulatorOptions> parseOptions(int argc, char* argv[]);
+
+  void printUsage();
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Securities
+
+  struct SimulatedSecurity
+  {
+    std::string code;
+
+    // Mid, percent of par
+    double price;
+
+    double yield;
+  };
+
+  // Treasury style ISINs around par
+  std::vector<SimulatedSecurity> makeSecurities(const SimulatorOptions& options);
+
+} // Namespace FixClientSimulator
@@ -0,0 +1,474 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// venue.cpp
+// FixClientSimulator
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <algorithm>
+#include <chrono>
+
+#include <fmt/core.h>
+
+#include "venue.hpp"
+
+namespace FixClientSimulator {
+
+  namespace {
+
+    // Next business day is close enough for a simulator
+    std::string settlementDate()
+    {
+      using namespace std::chrono;
+
+      const year_month_day date {
+        floor<days>(system_clock::now() + days { 1 })
+      };
+
+      return fmt::format("{:04d}{:02d}{:02d}",
+        static_cast<int>(date.year()),
+        static_cast<unsigned>(date.month()),
+        static_cast<unsigned>(date.day())
+      );
+    }
+
+    // Par amount, a 30 day accrual period
+    double accruedInterest(double quantity, double yield)
+    {
+      return quantity * yield / 100.0 * 30.0 / 360.0;
+    }
+
+    void addParty(FIX44::ExecutionReport& message, const std::string& id,
+      int role)
+    {
+      FIX44::ExecutionReport::NoPartyIDs party;
+      party.set(FIX::PartyID(id));
+      party.set(FIX::PartyRole(role));
+      message.addGroup(party);
+    }
+
+  }
+
+  SessionRole roleOf(const FIX::SessionID& sessionID)
+  {
+    const std::string& sender = sessionID.getSenderCompID();
+
+    if (sender.ends_with("-MD")) {
+      return SessionRole::MarketData;
+    }
+    if (sender.ends_with("-OB")) {
+      return SessionRole::OrderBook;
+    }
+    if (sender.ends_with("-TR")) {
+      return SessionRole::Trading;
+    }
+    return SessionRole::Unknown;
+  }
+
+  Venue::Venue(const SimulatorOptions& options,
+    const std::vector<SimulatedSecurity>& securities) :
+    options_(options),
+    securities_(securities)
+  {
+    // Nada
+  }
+
+  std::vector<FIX::SessionID> Venue::sessions(SessionRole role) const
+  {
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+
+    std::vector<FIX::SessionID> result;
+    for (const FIX::SessionID& sessionID : sessions_) {
+      if (roleOf(sessionID) == role) {
+        result.push_back(sessionID);
+      }
+    }
+    return result;
+  }
+
+  VenueStats Venue::stats() const
+  {
+    return VenueStats {
+      .orders = ordersReceived_.load(std::memory_order_relaxed),
+      .executionReports = executionReports_.load(std::memory_order_relaxed)
+    };
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: QuickFIX Boilerplate
+
+  void Venue::onCreate([[ maybe_unused ]] const FIX::SessionID& sessionID)
+  {
+    // Nada
+  }
+
+  void Venue::onLogon(const FIX::SessionID& sessionID)
+  {
+    fmt::print("Logon {}\n", sessionID.toString());
+
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    sessions_.push_back(sessionID);
+    sessionsGeneration_.fetch_add(1, std::memory_order_release);
+  }
+
+  void Venue::onLogout(const FIX::SessionID& sessionID)
+  {
+    fmt::print("Logout {}\n", sessionID.toString());
+
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    std::erase(sessions_, sessionID);
+    sessionsGeneration_.fetch_add(1, std::memory_order_release);
+  }
+
+  void Venue::toAdmin([[ maybe_unused ]] FIX::Message& message,
+    [[ maybe_unused ]] const FIX::SessionID& sessionID)
+  {
+    // Nada
+  }
+
+  void Venue::toApp([[ maybe_unused ]] FIX::Message& message,
+    [[ maybe_unused ]] const FIX::SessionID& sessionID)
+  {
+    // Nada
+  }
+
+  void Venue::fromAdmin([[ maybe_unused ]] const FIX::Message& message,
+    [[ maybe_unused ]] const FIX::SessionID& sessionID)
+  {
+    // Nada
+  }
+
+  // Anything not handled below is answered with a Business Reject
+  void Venue::fromApp(const FIX::Message& message,
+    const FIX::SessionID& sessionID)
+  {
+    crack(message, sessionID);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: OPENYIELD-TR
+
+  void Venue::onMessage(const FIX44::SecurityListRequest& message,
+    const FIX::SessionID& sessionID)
+  {
+    FIX::SecurityReqID securityReqId;
+    message.get(securityReqId);
+
+    FIX44::SecurityList list;
+    list.set(securityReqId);
+    list.set(FIX::SecurityResponseID(securityReqId.getValue()));
+    list.set(FIX::SecurityRequestResult(
+      FIX::SecurityRequestResult_VALID_REQUEST
+    ));
+
+    for (const SimulatedSecurity& security : securities_) {
+      FIX44::SecurityList::NoRelatedSym group;
+      group.set(FIX::Symbol(security.code));
+      group.set(FIX::SecurityID(security.code));
+      group.set(FIX::SecurityIDSource(FIX::SecurityIDSource_ISIN_NUMBER));
+      list.addGroup(group);
+    }
+
+    FIX::Session::sendToTarget(list, sessionID);
+  }
+
+  void Venue::onMessage(const FIX44::NewOrderSingle& message,
+    const FIX::SessionID& sessionID)
+  {
+    ordersReceived_.fetch_add(1, std::memory_order_relaxed);
+
+    FIX::ClOrdID clOrdId;
+    FIX::Side side;
+    FIX::SecurityID securityId;
+    FIX::OrderQty orderQty;
+    FIX::Price price;
+    message.get(clOrdId);
+    message.get(side);
+    message.get(securityId);
+    message.get(orderQty);
+    message.get(price);
+
+    ++newOrders_;
+
+    if (orderQty.getValue() <= 0) {
+      reject(clOrdId.getValue(), side.getValue(),
+        FIX::OrdRejReason_INCORRECT_QUANTITY, "Quantity must be positive",
+        sessionID);
+      return;
+    }
+
+    if (options_.rejectEvery > 0 && newOrders_ % options_.rejectEvery == 0) {
+      reject(clOrdId.getValue(), side.getValue(),
+        FIX::OrdRejReason_OTHER, "Simulated reject", sessionID);
+      return;
+    }
+
+    OpenOrder order {
+      .orderId = fmt::format("SIM{:010d}", nextOrderId_++),
+      .clOrdId = clOrdId.getValue(),
+      .securityCode = securityId.getValue(),
+      .side = side.getValue(),
+      .quantity = orderQty.getValue(),
+      .price = price.getValue(),
+      .cumulativeQuantity = 0
+    };
+
+    FIX44::ExecutionReport ack =
+      executionReport(order, FIX::ExecType_NEW, FIX::OrdStatus_NEW);
+    send(ack, sessionID);
+
+    if (options_.fills == 0) {
+      orders_.insert_or_assign(order.clOrdId, std::move(order));
+      return;
+    }
+
+    const double slice = order.quantity / options_.fills;
+    for (std::size_t i = 1; i < options_.fills; ++i) {
+      fill(order, slice, sessionID);
+    }
+    fill(order, order.quantity - order.cumulativeQuantity, sessionID);
+  }
+
+  // A zero quantity cancels, that is how OrderDispatch sends cancels
+  void Venue::onMessage(const FIX44::OrderCancelReplaceRequest& message,
+    const FIX::SessionID& sessionID)
+  {
+    FIX::OrigClOrdID origClOrdId;
+    FIX::ClOrdID clOrdId;
+    FIX::Side side;
+    FIX::OrderQty orderQty;
+    message.get(origClOrdId);
+    message.get(clOrdId);
+    message.get(side);
+    message.get(orderQty);
+
+    ordersReceived_.fetch_add(1, std::memory_order_relaxed);
+
+    auto found = orders_.find(origClOrdId.getValue());
+    if (found == orders_.end()) {
+      reject(clOrdId.getValue(), side.getValue(),
+        FIX::OrdRejReason_UNKNOWN_ORDER, "Unknown order", sessionID);
+      return;
+    }
+
+    OpenOrder order = std::move(found->second);
+    orders_.erase(found);
+    order.clOrdId = clOrdId.getValue();
+
+    if (orderQty.getValue() == 0) {
+      FIX44::ExecutionReport canceled = executionReport(
+        order, FIX::ExecType_CANCELED, FIX::OrdStatus_CANCELED
+      );
+      canceled.set(origClOrdId);
+      send(canceled, sessionID);
+      return;
+    }
+
+    FIX::Price price;
+    if (message.getIfSet(price)) {
+      order.price = price.getValue();
+    }
+    order.quantity = orderQty.getValue();
+
+    FIX44::ExecutionReport replaced = executionReport(
+      order, FIX::ExecType_REPLACED, FIX::OrdStatus_REPLACED
+    );
+    replaced.set(origClOrdId);
+    send(replaced, sessionID);
+
+    orders_.insert_or_assign(order.clOrdId, std::move(order));
+  }
+
+  void Venue::onMessage(const FIX44::OrderCancelRequest& message,
+    const FIX::SessionID& sessionID)
+  {
+    FIX::OrigClOrdID origClOrdId;
+    FIX::ClOrdID clOrdId;
+    FIX::Side side;
+    message.get(origClOrdId);
+    message.get(clOrdId);
+    message.get(side);
+
+    ordersReceived_.fetch_add(1, std::memory_order_relaxed);
+
+    auto found = orders_.find(origClOrdId.getValue());
+    if (found == orders_.end()) {
+      reject(clOrdId.getValue(), side.getValue(),
+        FIX::OrdRejReason_UNKNOWN_ORDER, "Unknown order", sessionID);
+      return;
+    }
+
+    OpenOrder order = std::move(found->second);
+    orders_.erase(found);
+    order.clOrdId = clOrdId.getValue();
+
+    FIX44::ExecutionReport canceled = executionReport(
+      order, FIX::ExecType_CANCELED, FIX::OrdStatus_CANCELED
+    );
+    canceled.set(origClOrdId);
+    send(canceled, sessionID);
+  }
+
+  // Cancel all
+  void Venue::onMessage([[ maybe_unused ]] const FIX44::QuoteCancel& message,
+    const FIX::SessionID& sessionID)
+  {
+    for (auto& [clOrdId, order] : orders_) {
+      FIX44::ExecutionReport canceled = executionReport(
+        order, FIX::ExecType_CANCELED, FIX::OrdStatus_CANCELED
+      );
+      canceled.set(FIX::Text("Cancel all"));
+      send(canceled, sessionID);
+    }
+    orders_.clear();
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Execution Reports
+
+  FIX44::ExecutionReport Venue::executionReport(const OpenOrder& order,
+    char execType, char ordStatus)
+  {
+    const double leaves = execType == FIX::ExecType_CANCELED
+      ? 0.0
+      : order.quantity - order.cumulativeQuantity;
+
+    FIX44::ExecutionReport message(
+      FIX::OrderID(order.orderId),
+      FIX::ExecID(nextExecId()),
+      FIX::ExecType(execType),
+      FIX::OrdStatus(ordStatus),
+      FIX::Side(order.side),
+      FIX::LeavesQty(leaves),
+      FIX::CumQty(order.cumulativeQuantity),
+      FIX::AvgPx(order.cumulativeQuantity > 0 ? order.price : 0.0)
+    );
+
+    message.set(FIX::ClOrdID(order.clOrdId));
+    message.set(FIX::Symbol(order.securityCode));
+    message.set(FIX::SecurityID(order.securityCode));
+    message.set(FIX::SecurityIDSource(FIX::SecurityIDSource_ISIN_NUMBER));
+    message.set(FIX::OrderQty(order.quantity));
+    message.set(FIX::Price(order.price));
+    message.set(FIX::TransactTime());
+
+    // The client reads the party groups of every report
+    addParty(message, "OPENYIELD", FIX::PartyRole_EXECUTING_FIRM);
+
+    return message;
+  }
+
+  void Venue::fill(OpenOrder& order, double quantity,
+    const FIX::SessionID& sessionID)
+  {
+    order.cumulativeQuantity += quantity;
+
+    const bool complete = order.cumulativeQuantity >= order.quantity;
+    const double yield = 4.0 + (100.0 - order.price) / 8.0;
+    const double principal = quantity * order.price / 100.0;
+    const double accrued = accruedInterest(quantity, yield);
+
+    FIX44::ExecutionReport message = executionReport(
+      order,
+      FIX::ExecType_TRADE,
+      complete ? FIX::OrdStatus_FILLED : FIX::OrdStatus_PARTIALLY_FILLED
+    );
+
+    FIX44::ExecutionReport::NoPartyIDs contra;
+    contra.set(FIX::PartyID("SIMCONTRA"));
+    contra.set(FIX::PartyRole(FIX::PartyRole_CONTRA_FIRM));
+    FIX44::ExecutionReport::NoPartyIDs::NoPartySubIDs account;
+    account.set(FIX::PartySubID("SIMCONTRA-0001"));
+    account.set(FIX::PartySubIDType(1));
+    contra.addGroup(account);
+    message.addGroup(contra);
+
+    addParty(message, "SIMSUBSCRIBER", FIX::PartyRole_CUSTOMER_ACCOUNT);
+
+    message.set(FIX::LastQty(quantity));
+    message.set(FIX::LastPx(order.price));
+    message.set(FIX::Yield(yield));
+    message.set(FIX::GrossTradeAmt(principal));
+    message.set(FIX::AccruedInterestAmt(accrued));
+    message.set(FIX::NetMoney(principal + accrued));
+    message.set(FIX::SettlDate(settlementDate()));
+
+    FIX::ExecID execId;
+    message.get(execId);
+    send(message, sessionID);
+
+    ++fills_;
+    if (options_.correctEvery > 0 && fills_ % options_.correctEvery == 0) {
+      correct(order, execId.getValue(), quantity, sessionID);
+    }
+  }
+
+  // Moves the fill up a 32nd
+  void Venue::correct(const OpenOrder& order, const std::string& execId,
+    double quantity, const FIX::SessionID& sessionID)
+  {
+    const double price = order.price + 1.0 / 32.0;
+    const double yield = 4.0 + (100.0 - price) / 8.0;
+    const double principal = quantity * price / 100.0;
+    const double accrued = accruedInterest(quantity, yield);
+
+    FIX44::ExecutionReport message = executionReport(
+      order,
+      FIX::ExecType_TRADE_CORRECT,
+      order.cumulativeQuantity >= order.quantity
+        ? FIX::OrdStatus_FILLED
+        : FIX::OrdStatus_PARTIALLY_FILLED
+    );
+
+    message.set(FIX::ExecRefID(execId));
+    message.set(FIX::LastQty(quantity));
+    message.set(FIX::LastPx(price));
+    message.set(FIX::Yield(yield));
+    message.set(FIX::GrossTradeAmt(principal));
+    message.set(FIX::AccruedInterestAmt(accrued));
+    message.set(FIX::NetMoney(principal + accrued));
+
+    send(message, sessionID);
+  }
+
+  void Venue::reject(const std::string& clOrdId, char side, int reason,
+    const std::string& text, const FIX::SessionID& sessionID)
+  {
+    FIX44::ExecutionReport message(
+      FIX::OrderID("NONE"),
+      FIX::ExecID(nextExecId()),
+      FIX::ExecType(FIX::ExecType_REJECTED),
+      FIX::OrdStatus(FIX::OrdStatus_REJECTED),
+      FIX::Side(side),
+      FIX::LeavesQty(0),
+      FIX::CumQty(0),
+      FIX::AvgPx(0)
+    );
+
+    message.set(FIX::ClOrdID(clOrdId));
+    message.set(FIX::OrdRejReason(reason));
+    message.set(FIX::Text(text));
+    message.set(FIX::TransactTime());
+    addParty(message, "OPENYIELD", FIX::PartyRole_EXECUTING_FIRM);
+
+    send(message, sessionID);
+  }
+
+  void Venue::send(FIX::Message& message, const FIX::SessionID& sessionID)
+  {
+    FIX::Session::sendToTarget(message, sessionID);
+    executionReports_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::string Venue::nextExecId()
+  {
+    return fmt::format("SIMEX{:012d}", nextExecId_++);
+  }
+
+} // Namespace FixClientSimulator
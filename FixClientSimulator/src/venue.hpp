@@ -0,0 +1,191 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// venue.hpp
+// FixClientSimulator
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+//    ┌───────────────────────────────────────────────────────────────┐
+//    │                                                               │
+//    │  Simulated Venue                                              │░░
+//    │                                                               │░░
+//    │  - Accepts the -MD, -OB and -TR sessions                      │░░
+//    │  - Answers orders with acks, fills, rejects and corrections   │░░
+//    │                                                               │░░
+//    └───────────────────────────────────────────────────────────────┘░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//      ░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░
+//
+// Speaks the OpenYield dialect the library decodes, with no matching:
+// a new order is acknowledged and filled right away against a made up
+// contra, in the configured number of fills. An OrderCancelReplace
+// with a zero quantity is a cancel, as OrderDispatch sends them.
+//
+// The MarketFeed pushes the unsolicited traffic.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "quickfix.hpp"
+
+#include "simulator_options.hpp"
+
+namespace FixClientSimulator {
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Session Role
+
+  enum class SessionRole : std::uint8_t {
+
+    MarketData,
+
+    OrderBook,
+
+    Trading,
+
+    Unknown
+
+  };
+
+  // From our SenderCompID, OPENYIELD-MD and so on
+  SessionRole roleOf(const FIX::SessionID& sessionID);
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Venue Stats
+
+  struct VenueStats
+  {
+    std::uint64_t orders { 0 };
+    std::uint64_t executionReports { 0 };
+  };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Venue
+
+  class Venue :
+    public FIX::Application,
+    public FIX44::MessageCracker
+  {
+
+  public:
+
+    Venue(const SimulatorOptions& options,
+      const std::vector<SimulatedSecurity>& securities);
+
+    // Logged on sessions of a role
+    std::vector<FIX::SessionID> sessions(SessionRole role) const;
+
+    // Bumped on every logon and logout
+    std::uint64_t sessionsGeneration() const
+    {
+      return sessionsGeneration_.load(std::memory_order_acquire);
+    }
+
+    VenueStats stats() const;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: QuickFIX Boilerplate
+
+    void onCreate(const FIX::SessionID& sessionID) override;
+
+    void onLogon(const FIX::SessionID& sessionID) override;
+
+    void onLogout(const FIX::SessionID& sessionID) override;
+
+    void toAdmin(FIX::Message& message,
+      const FIX::SessionID& sessionID) override;
+
+    void toApp(FIX::Message& message,
+      const FIX::SessionID& sessionID) override;
+
+    void fromAdmin(const FIX::Message& message,
+      const FIX::SessionID& sessionID) override;
+
+    void fromApp(const FIX::Message& message,
+      const FIX::SessionID& sessionID) override;
+
+  private:
+
+    struct OpenOrder
+    {
+      std::string orderId;
+      std::string clOrdId;
+      std::string securityCode;
+      char side;
+      double quantity;
+      double price;
+      double cumulativeQuantity;
+    };
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: OPENYIELD-TR
+
+    void onMessage(const FIX44::SecurityListRequest& message,
+      const FIX::SessionID& sessionID) override;
+
+    void onMessage(const FIX44::NewOrderSingle& message,
+      const FIX::SessionID& sessionID) override;
+
+    void onMessage(const FIX44::OrderCancelReplaceRequest& message,
+      const FIX::SessionID& sessionID) override;
+
+    void onMessage(const FIX44::OrderCancelRequest& message,
+      const FIX::SessionID& sessionID) override;
+
+    void onMessage(const FIX44::QuoteCancel& message,
+      const FIX::SessionID& sessionID) override;
+
+  // -------- -------- -------- -------- -------- -------- -------- --------
+  // MARK: Execution Reports
+
+    FIX44::ExecutionReport executionReport(const OpenOrder& order,
+      char execType, char ordStatus);
+
+    void fill(OpenOrder& order, double quantity,
+      const FIX::SessionID& sessionID);
+
+    void correct(const OpenOrder& order, const std::string& execId,
+      double quantity, const FIX::SessionID& sessionID);
+
+    void reject(const std::string& clOrdId, char side, int reason,
+      const std::string& text, const FIX::SessionID& sessionID);
+
+    void send(FIX::Message& message, const FIX::SessionID& sessionID);
+
+    std::string nextExecId();
+
+    const SimulatorOptions& options_;
+    const std::vector<SimulatedSecurity>& securities_;
+
+    mutable std::mutex sessionsMutex_;
+    std::vector<FIX::SessionID> sessions_;
+    std::atomic<std::uint64_t> sessionsGeneration_ { 0 };
+
+    // By ClOrdID. The TR session is the only one touching it.
+    std::unordered_map<std::string, OpenOrder> orders_;
+
+    std::uint64_t nextOrderId_ { 1 };
+    std::uint64_t nextExecId_ { 1 };
+    std::uint64_t newOrders_ { 0 };
+    std::uint64_t fills_ { 0 };
+
+    std::atomic<std::uint64_t> ordersReceived_ { 0 };
+    std::atomic<std::uint64_t> executionReports_ { 0 };
+
+  };
+
+} // Namespace FixClientSimulator
@@ -0,0 +1,43 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// allocation_count.hpp
+// FixClientTest
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Counts heap allocations made by the test binary. The global operator
+// new is replaced in allocation_count.cpp.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#pragma once
+
+#include <cstdint>
+
+namespace FixClientTest {
+
+  // Allocations since the process started, all threads
+  std::uint64_t allocationCount();
+
+  // Runs work once to grow its buffers, then returns how many
+  // allocations the next runs made
+  template <typename Work>
+  std::uint64_t steadyStateAllocations(Work&& work, int runs = 16)
+  {
+    work();
+
+    const std::uint64_t start = allocationCount();
+
+    for (int run = 0; run < runs; ++run) {
+      work();
+    }
+    return allocationCount() - start;
+  }
+
+} // Namespace FixClientTest
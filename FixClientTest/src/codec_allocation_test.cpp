@@ -0,0 +1,168 @@
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// codec_allocation_test.cpp
+// FixClientTest
+//
+// Copyright © 2024 OpenYield, Inc.
+//
+// Use of this source code is governed by an MIT-style
+// license that can be found in the LICENSE file or at
+// https://opensource.org/licenses/MIT.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+//
+// Once their buffers have grown, the decoders that write into caller
+// owned buffers, models or sinks must not allocate.
+//
+// -------- -------- -------- -------- -------- -------- -------- --------
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "codec/execution_event.hpp"
+#include "codec/market_data.hpp"
+#include "codec/order_book.hpp"
+#include "codec/raw_market_data.hpp"
+#include "codec/security_list.hpp"
+#include "state/security_table.hpp"
+
+#include "allocation_count.hpp"
+#include "bench_messages.hpp"
+
+namespace FixClientTest {
+
+  using namespace FixClient;
+  using namespace FixClientBenchmark;
+
+  // Entries per message for the repeating groups
+  constexpr int entries = 64;
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Market Data
+
+  TEST(CodecAllocation, IncrementalRefreshIntoBuffer)
+  {
+    auto message = incrementalRefresh(entries);
+    SecurityTable securities;
+    MarketDataCodec codec(&securities);
+    std::vector<MarketDataModel> data;
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+      codec.onMarketDataIncrementalRefresh(message, data);
+    }), 0u);
+    EXPECT_EQ(data.size(), static_cast<std::size_t>(entries));
+  }
+
+  TEST(CodecAllocation, IncrementalRefreshSink)
+  {
+    auto message = incrementalRefresh(entries);
+    SecurityTable securities;
+    MarketDataCodec codec(&securities);
+    int count = 0;
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+      count = 0;
+      codec.onMarketDataIncrementalRefresh(message,
+        [&](const MarketDataModel&) {
+          ++count;
+        }
+      );
+    }), 0u);
+    EXPECT_EQ(count, entries);
+  }
+
+  TEST(CodecAllocation, SnapshotFullRefreshIntoBuffer)
+  {
+    auto message = snapshotFullRefresh(entries);
+    SecurityTable securities;
+    MarketDataCodec codec(&securities);
+    std::vector<MarketDataModel> data;
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+      codec.onMarketDataSnapshotFullRefresh(message, data);
+    }), 0u);
+    EXPECT_EQ(data.size(), static_cast<std::size_t>(entries));
+  }
+
+  TEST(CodecAllocation, RawIncrementalRefreshIntoBuffer)
+  {
+    auto message = incrementalRefresh(entries);
+    std::string raw = message.toString();
+    SecurityTable securities;
+    RawMarketDataCodec codec(&securities);
+    std::vector<MarketDataModel> data;
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+      codec.onMarketDataIncrementalRefresh(raw, data);
+    }), 0u);
+    EXPECT_EQ(data.size(), static_cast<std::size_t>(entries));
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: IOI
+
+  TEST(CodecAllocation, IOIIntoModel)
+  {
+    auto message = ioi(1);
+    SecurityTable securities;
+    OrderBookCodec codec(&securities);
+    IOIOrderModel model;
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+      codec.onIOI(message, model);
+    }), 0u);
+    EXPECT_FALSE(model.ioiCode.empty());
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Execution Reports
+
+  // Acknowledgement, fill with party groups, or trade correction
+  void expectExecutionReportWithoutAllocating(
+    FIX44::ExecutionReport (*build)())
+  {
+    auto message = build();
+    SecurityTable securities;
+    ExecutionEventCodec codec(&securities);
+    ExecutionEventModel event;
+    bool handled = false;
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+      handled = codec.onExecutionReport(message, event);
+    }), 0u);
+    EXPECT_TRUE(handled);
+  }
+
+  TEST(CodecAllocation, AcknowledgementIntoModel)
+  {
+    expectExecutionReportWithoutAllocating(orderAcknowledgement);
+  }
+
+  TEST(CodecAllocation, FillIntoModel)
+  {
+    expectExecutionReportWithoutAllocating(fill);
+  }
+
+  TEST(CodecAllocation, TradeCorrectionIntoModel)
+  {
+    expectExecutionReportWithoutAllocating(tradeCorrection);
+  }
+
+// -------- -------- -------- -------- -------- -------- -------- --------
+// MARK: Security List
+
+  TEST(CodecAllocation, SecurityListIntoBuffer)
+  {
+    auto message = securityList(entries);
+    SecurityCodec codec;
+    std::vector<SecurityModel> data;
+
+    EXPECT_EQ(steadyStateAllocations([&] {
+      codec.onSecurityList(message, data);
+    }), 0u);
+    EXPECT_EQ(data.size(), static_cast<std::size_t>(entries));
+  }
+
+} // Namespace FixClientTest